@@ -22,6 +22,51 @@ const attotime attotime::never(ATTOTIME_MAX_SECONDS, 0);
 
 
 
+//**************************************************************************
+//  WIDE MATH HELPERS
+//**************************************************************************
+
+// on x86-64, multiplication works on a single 128-bit attosecond count, which
+// takes one hardware divide instead of a chain of 64x32 divides through base
+// 1e9 halves; the generic 128-bit divide in libgcc is slower than the chain,
+// so other targets keep it, and so does division, where a divq by an
+// arbitrary factor gains nothing ("make benchmarks" runs attotimebench with
+// and without ATTOTIME_WIDE_MATH)
+#if !defined(ATTOTIME_WIDE_MATH) && defined(__GNUC__) && defined(__x86_64__) && !defined(SDLMAME_NOASM)
+#define ATTOTIME_WIDE_MATH 1
+#endif
+
+#if ATTOTIME_WIDE_MATH
+
+__extension__ typedef unsigned __int128 attoseconds_wide_t;
+
+
+//-------------------------------------------------
+//  divu_wide_rem - divide a 128-bit count by a
+//  64-bit divisor; the caller guarantees that
+//  the quotient fits in 64 bits
+//-------------------------------------------------
+
+INLINE UINT64 ATTR_FORCE_INLINE divu_wide_rem(attoseconds_wide_t dividend, UINT64 divisor, UINT64 *remainder)
+{
+	UINT64 quotient;
+
+	// throws arithmetic exception if result doesn't fit in 64 bits
+	__asm__ (
+		" divq  %[divisor] ;"
+		: [result]    "=a" (quotient)               /* quotient ends up in rax */
+		, [remainder] "=d" (*remainder)             /* remainder ends up in rdx */
+		: [divl]      "a"  ((UINT64)dividend)       /* 'dividend' in rdx:rax */
+		, [divh]      "d"  ((UINT64)(dividend >> 64))
+		, [divisor]   "rm" (divisor)                /* 'divisor' in register or memory */
+		: "cc"                                      /* clobbers condition codes */
+	);
+	return quotient;
+}
+#endif
+
+
+
 //**************************************************************************
 //  CORE MATH FUNCTIONS
 //**************************************************************************
@@ -41,6 +86,21 @@ attotime &attotime::operator*=(UINT32 factor)
 	if (factor == 0)
 		return *this = zero;
 
+#if ATTOTIME_WIDE_MATH
+	// scale the attoseconds as a single wide count; the carry into seconds fits in 32 bits
+	UINT64 reslo;
+	UINT64 temp = divu_wide_rem((attoseconds_wide_t)(UINT64)attoseconds * factor, ATTOSECONDS_PER_SECOND, &reslo);
+
+	// scale the seconds
+	temp += mulu_32x32(seconds, factor);
+	if (temp >= ATTOTIME_MAX_SECONDS)
+		return *this = never;
+
+	// build the result
+	seconds = temp;
+	attoseconds = reslo;
+	return *this;
+#else
 	// split attoseconds into upper and lower halves which fit into 32 bits
 	UINT32 attolo;
 	UINT32 attohi = divu_64x32_rem(attoseconds, ATTOSECONDS_PER_SECOND_SQRT, &attolo);
@@ -64,6 +124,7 @@ attotime &attotime::operator*=(UINT32 factor)
 	seconds = temp;
 	attoseconds = (attoseconds_t)reslo + mul_32x32(reshi, ATTOSECONDS_PER_SECOND_SQRT);
 	return *this;
+#endif
 }
 
 
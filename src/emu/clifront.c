@@ -23,6 +23,9 @@
 
 #include <new>
 #include <ctype.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 
 //**************************************************************************
@@ -63,6 +66,7 @@ const options_entry cli_options::s_option_entries[] =
 	{ CLICOMMAND_GETSOFTLIST ";glist",  "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist", "0",     OPTION_COMMAND,    "verify software list by name" },
 	{ CLICOMMAND_LIST_MIDI_DEVICES ";mlist", "0",  OPTION_COMMAND,    "list available MIDI I/O devices" },
+	{ CLICOMMAND_BENCHMARK ";bm",       "0",       OPTION_COMMAND,    "run each of a comma-separated list of drivers headless and report speed as JSON" },
 	{ NULL }
 };
 
@@ -94,7 +98,9 @@ cli_options::cli_options()
 cli_frontend::cli_frontend(cli_options &options, osd_interface &osd)
 	: m_options(options),
 		m_osd(osd),
-		m_result(MAMERR_NONE)
+		m_result(MAMERR_NONE),
+		m_bench_start(0),
+		m_bench_rss_reset(false)
 {
 	// begin tracking memory
 	track_memory(true);
@@ -1600,6 +1606,161 @@ void cli_frontend::romident(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  reset_peak_rss - reset the peak resident set
+//  size of the process, where the OS allows it
+//-------------------------------------------------
+
+static bool reset_peak_rss()
+{
+#ifdef __linux__
+	// writing 5 to clear_refs resets VmHWM (Linux 4.0 and later)
+	FILE *file = fopen("/proc/self/clear_refs", "w");
+	if (file == NULL)
+		return false;
+	bool success = (fputs("5", file) >= 0);
+	return (fclose(file) == 0 && success);
+#else
+	return false;
+#endif
+}
+
+
+//-------------------------------------------------
+//  peak_rss_kb - return the peak resident set
+//  size of the process in KB, or -1 if unknown
+//-------------------------------------------------
+
+static INT64 peak_rss_kb()
+{
+#ifdef __linux__
+	// VmHWM honors a reset_peak_rss, ru_maxrss does not
+	FILE *file = fopen("/proc/self/status", "r");
+	if (file != NULL)
+	{
+		char line[256];
+		INT64 peak = -1;
+		while (fgets(line, sizeof(line), file) != NULL)
+			if (strncmp(line, "VmHWM:", 6) == 0)
+				peak = strtol(&line[6], NULL, 10);
+		fclose(file);
+		if (peak >= 0)
+			return peak;
+	}
+#endif
+#ifndef _WIN32
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+		return usage.ru_maxrss / 1024;
+#else
+		return usage.ru_maxrss;
+#endif
+#endif
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  benchmark - run each driver in a comma-
+//  separated list of names or wildcards for a
+//  fixed emulated time, and print the results
+//  as JSON on stdout
+//-------------------------------------------------
+
+void cli_frontend::benchmark(const char *gamename)
+{
+	// collect the drivers from each comma-separated pattern
+	dynamic_array<const game_driver *> drivers;
+	astring pattern;
+	for (const char *start = gamename; start != NULL; )
+	{
+		const char *comma = strchr(start, ',');
+		if (comma != NULL)
+			pattern.cpy(start, comma - start);
+		else
+			pattern.cpy(start);
+		start = (comma != NULL) ? comma + 1 : NULL;
+
+		driver_enumerator drivlist(m_options, pattern);
+		if (drivlist.count() == 0)
+			throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", pattern.cstr());
+		while (drivlist.next())
+			if ((drivlist.driver().flags & GAME_NO_STANDALONE) == 0)
+				drivers.append(&drivlist.driver());
+	}
+
+	// run headless and unthrottled for a fixed time; -str picks the time, 60 seconds if unset
+	astring error_string;
+	int seconds = (m_options.seconds_to_run() != 0) ? m_options.seconds_to_run() : 60;
+	m_options.set_value(OPTION_SECONDS_TO_RUN, seconds, OPTION_PRIORITY_MAXIMUM, error_string);
+	m_options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM, error_string);
+	m_options.set_value(OPTION_SOUND, false, OPTION_PRIORITY_MAXIMUM, error_string);
+	if (m_options.exists("video"))
+		m_options.set_value("video", "none", OPTION_PRIORITY_MAXIMUM, error_string);
+	assert(!error_string);
+
+	// keep stdout for the results; the usual info output goes to stderr meanwhile
+	output_delegate prevcb = mame_set_output_channel(OUTPUT_CHANNEL_INFO, output_delegate(FUNC(mame_file_output_callback), stderr));
+
+	// run them all
+	m_bench_results.reset();
+	for (int drvnum = 0; drvnum < drivers.count(); drvnum++)
+	{
+		m_options.set_system_name(drivers[drvnum]->name);
+		m_bench_rss_reset = reset_peak_rss();
+		m_bench_start = osd_ticks();
+		int error = mame_execute(m_options, m_osd, machine_finished_delegate(FUNC(cli_frontend::benchmark_finished), this));
+		if (error != MAMERR_NONE && m_result == MAMERR_NONE)
+			m_result = error;
+	}
+	mame_set_output_channel(OUTPUT_CHANNEL_INFO, prevcb);
+
+	printf("{\n\t\"build\": \"%s\",\n\t\"seconds_to_run\": %d,\n\t\"drivers\": [%s\n\t]\n}\n", build_version, seconds, m_bench_results.cstr());
+}
+
+
+//-------------------------------------------------
+//  benchmark_finished - record the results of
+//  one benchmark run
+//-------------------------------------------------
+
+void cli_frontend::benchmark_finished(running_machine &machine, int error)
+{
+	double wall = (double)(osd_ticks() - m_bench_start) / (double)osd_ticks_per_second();
+
+	// peak resident set size in KB; unless it was reset before this run, it is
+	// the peak of the whole process so far, which includes earlier games
+	INT64 peak_rss = peak_rss_kb();
+
+	if (m_bench_results)
+		m_bench_results.cat(",");
+	m_bench_results.catprintf("\n\t\t{\n\t\t\t\"name\": \"%s\",\n\t\t\t\"result\": %d", machine.system().name, error);
+	if (error == MAMERR_NONE)
+	{
+		m_bench_results.catprintf(",\n\t\t\t\"wall_seconds\": %.3f", wall);
+		m_bench_results.catprintf(",\n\t\t\t\"emulated_seconds\": %.3f", machine.time().as_double());
+		m_bench_results.catprintf(",\n\t\t\t\"speed\": %.4f", machine.video().average_speed());
+		m_bench_results.catprintf(",\n\t\t\t\"cpus\": [");
+
+		// per-device cycles as counted by the scheduler
+		const char *separator = "";
+		execute_interface_iterator iter(machine.root_device());
+		for (device_execute_interface *exec = iter.first(); exec != NULL; exec = iter.next())
+		{
+			scheduler_device_stats *stats = machine.scheduler().stats(exec->device());
+			m_bench_results.catprintf("%s\n\t\t\t\t{ \"tag\": \"%s\", \"clock\": %u, \"cycles\": %" I64FMT "u }",
+					separator, exec->device().tag(), exec->device().clock(), (stats != NULL) ? stats->m_cycles : 0);
+			separator = ",";
+		}
+		m_bench_results.cat("\n\t\t\t]");
+	}
+	if (peak_rss >= 0)
+		m_bench_results.catprintf(",\n\t\t\t\"%s\": %" I64FMT "d", m_bench_rss_reset ? "peak_rss_kb" : "process_peak_rss_kb", peak_rss);
+	m_bench_results.cat("\n\t\t}");
+}
+
+
 //-------------------------------------------------
 //  execute_commands - execute various frontend
 //  commands
@@ -1686,6 +1847,7 @@ void cli_frontend::execute_commands(const char *exename)
 		{ CLICOMMAND_GETSOFTLIST,   &cli_frontend::getsoftlist },
 		{ CLICOMMAND_VERIFYSOFTLIST,    &cli_frontend::verifysoftlist },
 		{ CLICOMMAND_LIST_MIDI_DEVICES, &cli_frontend::listmididevices },
+		{ CLICOMMAND_BENCHMARK,     &cli_frontend::benchmark },
 	};
 
 	// find the command
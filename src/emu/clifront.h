@@ -50,6 +50,7 @@
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
 #define CLICOMMAND_LIST_MIDI_DEVICES    "listmidi"
+#define CLICOMMAND_BENCHMARK            "benchmark"
 
 
 //**************************************************************************
@@ -101,6 +102,7 @@ public:
 	void getsoftlist(const char *gamename = "*");
 	void verifysoftlist(const char *gamename = "*");
 	void listmididevices(const char *gamename = "*");
+	void benchmark(const char *gamename = "*");
 
 private:
 	// internal helpers
@@ -108,11 +110,17 @@ private:
 	void display_help();
 	void display_suggestions(const char *gamename);
 	void output_single_softlist(FILE *out,software_list *list, const char *listname);
+	void benchmark_finished(running_machine &machine, int error);
 
 	// internal state
 	cli_options &       m_options;
 	osd_interface &     m_osd;
 	int                 m_result;
+
+	// benchmark state
+	osd_ticks_t         m_bench_start;          // ticks when the current run started
+	bool                m_bench_rss_reset;      // was the peak RSS reset before the current run?
+	astring             m_bench_results;        // JSON objects for the finished runs
 };
 
 
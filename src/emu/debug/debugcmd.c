@@ -147,6 +147,7 @@ static void execute_trackpc(running_machine &machine, int ref, int params, const
 static void execute_trackmem(running_machine &machine, int ref, int params, const char **param);
 static void execute_pcatmem(running_machine &machine, int ref, int params, const char **param);
 static void execute_snap(running_machine &machine, int ref, int params, const char **param);
+static void execute_schedstats(running_machine &machine, int ref, int params, const char **param);
 static void execute_source(running_machine &machine, int ref, int params, const char **param);
 static void execute_map(running_machine &machine, int ref, int params, const char **param);
 static void execute_memdump(running_machine &machine, int ref, int params, const char **param);
@@ -384,6 +385,8 @@ void debug_command_init(running_machine &machine)
 
 	debug_console_register_command(machine, "snap",      CMDFLAG_NONE, 0, 0, 1, execute_snap);
 
+	debug_console_register_command(machine, "schedstats", CMDFLAG_NONE, 0, 0, 0, execute_schedstats);
+
 	debug_console_register_command(machine, "source",    CMDFLAG_NONE, 0, 1, 1, execute_source);
 
 	debug_console_register_command(machine, "map",       CMDFLAG_NONE, AS_PROGRAM, 1, 1, execute_map);
@@ -2850,6 +2853,18 @@ static void execute_snap(running_machine &machine, int ref, int params, const ch
 }
 
 
+/*-------------------------------------------------
+    execute_schedstats - execute the schedstats
+    command
+-------------------------------------------------*/
+
+static void execute_schedstats(running_machine &machine, int ref, int params, const char *param[])
+{
+	astring buffer;
+	debug_console_printf(machine, "%s", machine.scheduler().stats_text(buffer));
+}
+
+
 /*-------------------------------------------------
     execute_source - execute the source command
 -------------------------------------------------*/
@@ -97,6 +97,7 @@ static const help_item static_help_list[] =
 		"  statesave[ss] <filename> -- save a state file for the current driver\n"
 		"  stateload[sl] <filename> -- load a state file for the current driver\n"
 		"  snap [<filename>] -- save a screen snapshot.\n"
+		"  schedstats -- display per-device scheduler statistics\n"
 		"  source <filename> -- reads commands from <filename> and executes them one by one\n"
 		"  quit -- exits MAME and the debugger\n"
 	},
@@ -486,6 +487,22 @@ static const help_item static_help_list[] =
 		"  Takes a snapshot of the current video screen and saves it as 'shinobi.png' in the configured "
 		"  snapshot directory.\n"
 	},
+	{
+		"schedstats",
+		"\n"
+		"  schedstats\n"
+		"\n"
+		"The schedstats command displays the counters the scheduler keeps for each device since the "
+		"machine started: cycles executed, timeslices run, timeslices aborted early, interleave boosts "
+		"requested, triggers that resumed the device, suspend requests, and timer callbacks fired. "
+		"Events that can't be charged to a device are listed under (machine). Devices with no "
+		"activity are omitted.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"schedstats\n"
+		"  Displays the statistics table.\n"
+	},
 	{
 		"source",
 		"\n"
@@ -54,6 +54,7 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 		m_icountptr(NULL),
 		m_cycles_running(0),
 		m_cycles_stolen(0),
+		m_stats(NULL),
 		m_suspend(0),
 		m_nextsuspend(0),
 		m_eatcycles(0),
@@ -197,6 +198,8 @@ void device_execute_interface::abort_timeslice()
 	// swallow the remaining cycles
 	if (m_icountptr != NULL)
 	{
+		if (m_stats != NULL)
+			m_stats->m_aborts++;
 		int delta = *m_icountptr;
 		m_cycles_stolen += delta;
 		m_cycles_running -= delta;
@@ -250,6 +253,8 @@ void device_execute_interface::suspend(UINT32 reason, bool eatcycles)
 {
 if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
 	// set the suspend reason and eat cycles flag
+	if (m_stats != NULL)
+		m_stats->m_suspends++;
 	m_nextsuspend |= reason;
 	m_nexteatcycles = eatcycles;
 	suspend_resume_changed();
@@ -315,6 +320,8 @@ void device_execute_interface::trigger(int trigid)
 	// see if this is a matching trigger
 	if ((m_nextsuspend & SUSPEND_REASON_TRIGGER) != 0 && m_trigger == trigid)
 	{
+		if (m_stats != NULL)
+			m_stats->m_triggers++;
 		resume(SUSPEND_REASON_TRIGGER);
 		m_trigger = 0;
 	}
@@ -490,6 +497,7 @@ void device_execute_interface::interface_pre_start()
 	int index = iter.indexof(*this);
 	m_suspend = SUSPEND_REASON_RESET;
 	m_profiler = profile_type(index + PROFILER_DEVICE_FIRST);
+	m_stats = device().machine().scheduler().stats(device());
 	m_inttrigger = index + TRIGGER_INT;
 
 	// fill in the input states and IRQ callback information
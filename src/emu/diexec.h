@@ -107,6 +107,7 @@ enum
 
 class emu_timer;
 class screen_device;
+struct scheduler_device_stats;
 
 
 // interrupt callback for VBLANK and timed interrupts
@@ -273,6 +274,7 @@ protected:
 	int *                   m_icountptr;                // pointer to the icount
 	int                     m_cycles_running;           // number of cycles we are executing
 	int                     m_cycles_stolen;            // number of cycles we artificially stole
+	scheduler_device_stats *m_stats;                    // scheduler statistics for this device
 
 	// suspend states
 	UINT32                  m_suspend;                  // suspend reason mask (0 = not suspended)
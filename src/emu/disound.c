@@ -23,7 +23,8 @@
 device_sound_interface::device_sound_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device),
 		m_outputs(0),
-		m_auto_allocated_inputs(0)
+		m_auto_allocated_inputs(0),
+		m_parallel_update(false)
 {
 }
 
@@ -383,6 +384,8 @@ device_mixer_interface::device_mixer_interface(const machine_config &mconfig, de
 		m_outputs(outputs),
 		m_mixer_stream(NULL)
 {
+	// mixing only reads our inputs
+	m_parallel_update = true;
 }
 
 
@@ -460,12 +463,14 @@ void device_mixer_interface::sound_stream_update(sound_stream &stream, stream_sa
 	for (int output = 0; output < m_outputs; output++)
 		memset(outputs[output], 0, samples * sizeof(outputs[0][0]));
 
-	// loop over samples
+	// add each input to the appropriate output a whole buffer at a time, which
+	// keeps the inner loop simple enough for the compiler to vectorize
 	const UINT8 *outmap = &m_outputmap[0];
-	for (int pos = 0; pos < samples; pos++)
+	for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
 	{
-		// for each input, add it to the appropriate output
-		for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
-			outputs[outmap[inp]][pos] += inputs[inp][pos];
+		stream_sample_t *dest = outputs[outmap[inp]];
+		const stream_sample_t *source = inputs[inp];
+		for (int pos = 0; pos < samples; pos++)
+			dest[pos] += source[pos];
 	}
 }
@@ -89,6 +89,7 @@ public:
 
 	// configuration access
 	const sound_route *first_route() const { return m_route_list.first(); }
+	bool parallel_update() const { return m_parallel_update; }
 
 	// static inline configuration helpers
 	static sound_route &static_add_route(device_t &device, UINT32 output, const char *target, double gain, UINT32 input = AUTO_ALLOC_INPUT, UINT32 mixoutput = 0);
@@ -120,6 +121,7 @@ protected:
 	simple_list<sound_route> m_route_list;      // list of sound routes
 	int             m_outputs;                  // number of outputs from this instance
 	int             m_auto_allocated_inputs;    // number of auto-allocated inputs targeting us
+	bool            m_parallel_update;          // our streams only touch our own state, so may update on another thread
 };
 
 // iterator
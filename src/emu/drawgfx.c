@@ -353,6 +353,7 @@ gfx_element::gfx_element(running_machine &machine)
 		m_srcdata(NULL),
 		m_dirtyseq(1),
 		m_gfxdata(NULL),
+		m_flipcache(false),
 		m_layout_is_raw(false),
 		m_layout_planes(0),
 		m_layout_charincrement(0),
@@ -377,6 +378,7 @@ gfx_element::gfx_element(running_machine &machine, UINT8 *base, UINT32 width, UI
 		m_srcdata(base),
 		m_dirtyseq(1),
 		m_gfxdata(base),
+		m_flipcache(false),
 		m_layout_is_raw(true),
 		m_layout_planes(0),
 		m_layout_charincrement(0),
@@ -401,6 +403,7 @@ gfx_element::gfx_element(running_machine &machine, const gfx_layout &gl, const U
 		m_srcdata(NULL),
 		m_dirtyseq(1),
 		m_gfxdata(NULL),
+		m_flipcache(false),
 		m_layout_is_raw(false),
 		m_layout_planes(0),
 		m_layout_charincrement(0),
@@ -469,11 +472,24 @@ void gfx_element::set_layout(const gfx_layout &gl, const UINT8 *srcdata)
 	m_dirty.resize(m_total_elements);
 	memset(m_dirty, 1, m_total_elements);
 
-	// allocate a pen usage array for entries with 32 pens or less
+	// allocate a pen usage array for entries with 32 pens or less, and a
+	// pen range array for larger decoded entries
+	m_pen_usage.reset();
+	m_pen_range.reset();
 	if (m_color_depth <= 32)
 		m_pen_usage.resize(m_total_elements);
-	else
-		m_pen_usage.reset();
+	else if (!m_layout_is_raw)
+		m_pen_range.resize(m_total_elements);
+
+	// keep pre-flipped copies of decoded sets that are small enough; raw
+	// data can change behind our back, so it never qualifies
+	UINT64 flipcache_limit = UINT64(machine().options().gfx_flipcache()) * 1024;
+	m_flipcache = (!m_layout_is_raw && m_total_elements > 0 && UINT64(m_total_elements) * m_char_modulo <= flipcache_limit);
+	for (int orient = 0; orient < ARRAY_LENGTH(m_flipdata); orient++)
+	{
+		m_flipdata[orient].reset();
+		m_flipdirty[orient].reset();
+	}
 
 	// set the source
 	set_source(srcdata);
@@ -566,11 +582,153 @@ void gfx_element::decode(UINT32 code)
 		m_pen_usage[code] = usage;
 	}
 
+	// (re)compute the pen range
+	else if (code < m_pen_range.count())
+	{
+		const UINT8 *dp = m_gfxdata + code * m_char_modulo;
+		UINT8 minpen = 0xff, maxpen = 0;
+		for (int y = 0; y < m_origheight; y++)
+		{
+			for (int x = 0; x < m_origwidth; x++)
+			{
+				minpen = MIN(minpen, dp[x]);
+				maxpen = MAX(maxpen, dp[x]);
+			}
+			dp += m_line_modulo;
+		}
+		m_pen_range[code] = (maxpen << 8) | minpen;
+	}
+
+	// any flipped copies are now out of date
+	for (int orient = 0; orient < ARRAY_LENGTH(m_flipdirty); orient++)
+		if (code < m_flipdirty[orient].count())
+			m_flipdirty[orient][code] = 1;
+
 	// no longer dirty
 	m_dirty[code] = 0;
 }
 
 
+//-------------------------------------------------
+//  get_flipped_data - return the data for a code
+//  from the copy flipped as given by 'orient'
+//  (bit 0 = X, bit 1 = Y), building it as needed
+//-------------------------------------------------
+
+const UINT8 *gfx_element::get_flipped_data(UINT32 code, int orient)
+{
+	assert(code < elements());
+	if (m_dirty[code])
+		decode(code);
+
+	// allocate the copy the first time this orientation is drawn
+	dynamic_buffer &flipdata = m_flipdata[orient - 1];
+	dynamic_buffer &flipdirty = m_flipdirty[orient - 1];
+	if (flipdata.count() == 0)
+	{
+		flipdata.resize(m_total_elements * m_char_modulo);
+		flipdirty.resize(m_total_elements);
+		memset(flipdirty, 1, m_total_elements);
+	}
+
+	// rebuild this code's copy if it is out of date
+	UINT8 *base = &flipdata[code * m_char_modulo];
+	if (flipdirty[code])
+	{
+		const UINT8 *src = m_gfxdata + code * m_char_modulo;
+		for (int y = 0; y < m_origheight; y++)
+		{
+			const UINT8 *srcrow = src + ((orient & 2) ? (m_origheight - 1 - y) : y) * m_line_modulo;
+			UINT8 *destrow = base + y * m_line_modulo;
+			if (orient & 1)
+			{
+				for (int x = 0; x < m_origwidth; x++)
+					destrow[x] = srcrow[m_origwidth - 1 - x];
+			}
+			else
+				memcpy(destrow, srcrow, m_origwidth);
+		}
+		flipdirty[code] = 0;
+	}
+
+	// the source clip window moves to the far side of each flipped axis
+	int startx = (orient & 1) ? (m_origwidth - m_startx - m_width) : m_startx;
+	int starty = (orient & 2) ? (m_origheight - m_starty - m_height) : m_starty;
+	return base + starty * m_line_modulo + startx;
+}
+
+
+//-------------------------------------------------
+//  transpen_opacity - classify a whole element
+//  against a single transparent pen
+//-------------------------------------------------
+
+gfx_opacity gfx_element::transpen_opacity(UINT32 code, UINT32 pen)
+{
+	// with pen usage we know exactly which pens are present
+	if (has_pen_usage())
+	{
+		UINT32 usage = pen_usage(code);
+		UINT32 penbit = (pen < 32) ? (1 << pen) : 0;
+		if ((usage & ~penbit) == 0)
+			return GFX_OPACITY_TRANSPARENT;
+		if ((usage & penbit) == 0)
+			return GFX_OPACITY_OPAQUE;
+	}
+
+	// otherwise, the pen range covers the common cases of a transparent pen at either end
+	else if (code < m_pen_range.count())
+	{
+		if (m_dirty[code])
+			decode(code);
+		UINT32 minpen = m_pen_range[code] & 0xff;
+		UINT32 maxpen = m_pen_range[code] >> 8;
+		if (pen < minpen || pen > maxpen)
+			return GFX_OPACITY_OPAQUE;
+		if (minpen == maxpen)
+			return GFX_OPACITY_TRANSPARENT;
+	}
+	return GFX_OPACITY_MIXED;
+}
+
+
+//-------------------------------------------------
+//  transmask_opacity - classify a whole element
+//  against a mask of transparent pens
+//-------------------------------------------------
+
+gfx_opacity gfx_element::transmask_opacity(UINT32 code, UINT32 mask)
+{
+	// with pen usage we know exactly which pens are present
+	if (has_pen_usage())
+	{
+		UINT32 usage = pen_usage(code);
+		if ((usage & ~mask) == 0)
+			return GFX_OPACITY_TRANSPARENT;
+		if ((usage & mask) == 0)
+			return GFX_OPACITY_OPAQUE;
+	}
+
+	// otherwise, compare the mask against the bits the pen range could use
+	else if (code < m_pen_range.count())
+	{
+		if (m_dirty[code])
+			decode(code);
+		UINT32 minpen = m_pen_range[code] & 0xff;
+		UINT32 maxpen = m_pen_range[code] >> 8;
+		if (maxpen < 32)
+		{
+			UINT32 rangebits = (0xffffffff >> (31 - maxpen)) & (0xffffffff << minpen);
+			if ((mask & rangebits) == 0)
+				return GFX_OPACITY_OPAQUE;
+			if (minpen == maxpen)
+				return GFX_OPACITY_TRANSPARENT;
+		}
+	}
+	return GFX_OPACITY_MIXED;
+}
+
+
 
 /***************************************************************************
     DRAWGFX IMPLEMENTATIONS
@@ -613,24 +771,22 @@ void gfx_element::transpen(palette_device &palette, bitmap_ind16 &dest, const re
 	if (trans_pen > 0xff)
 		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_SPAN_CORE(UINT16, SPAN_OP_REMAP_TRANSPEN, NO_PRIORITY);
 }
 
 void gfx_element::transpen(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -641,24 +797,22 @@ void gfx_element::transpen(palette_device &palette, bitmap_rgb32 &dest, const re
 	if (trans_pen > 0xff)
 		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_SPAN_CORE(UINT32, SPAN_OP_REMAP_TRANSPEN, NO_PRIORITY);
 }
 
 
@@ -674,7 +828,7 @@ void gfx_element::transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect,
 {
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// render
@@ -688,7 +842,7 @@ void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
 {
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// render
@@ -711,24 +865,22 @@ void gfx_element::transmask(palette_device &palette, bitmap_ind16 &dest, const r
 	if (trans_mask == 0)
 		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_SPAN_CORE(UINT16, SPAN_OP_REMAP_TRANSMASK, NO_PRIORITY);
 }
 
 void gfx_element::transmask(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -739,24 +891,22 @@ void gfx_element::transmask(palette_device &palette, bitmap_rgb32 &dest, const r
 	if (trans_mask == 0)
 		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_SPAN_CORE(UINT32, SPAN_OP_REMAP_TRANSMASK, NO_PRIORITY);
 }
 
 
@@ -809,13 +959,13 @@ void gfx_element::alpha(palette_device &palette, bitmap_rgb32 &dest, const recta
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// get final code and color, and grab lookup tables
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	DRAWGFX_SPAN_CORE(UINT32, SPAN_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
 }
 
 
@@ -877,19 +1027,17 @@ void gfx_element::zoom_transpen(palette_device &palette, bitmap_ind16 &dest, con
 	if (trans_pen > 0xff)
 		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
@@ -909,19 +1057,17 @@ void gfx_element::zoom_transpen(palette_device &palette, bitmap_rgb32 &dest, con
 	if (trans_pen > 0xff)
 		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
@@ -946,7 +1092,7 @@ void gfx_element::zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// render
@@ -964,7 +1110,7 @@ void gfx_element::zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprec
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// render
@@ -991,19 +1137,17 @@ void gfx_element::zoom_transmask(palette_device &palette, bitmap_ind16 &dest, co
 	if (trans_mask == 0)
 		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
@@ -1023,19 +1167,17 @@ void gfx_element::zoom_transmask(palette_device &palette, bitmap_rgb32 &dest, co
 	if (trans_mask == 0)
 		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley);
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
@@ -1105,7 +1247,7 @@ void gfx_element::zoom_alpha(palette_device &palette, bitmap_rgb32 &dest, const
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// render
@@ -1167,26 +1309,24 @@ void gfx_element::prio_transpen(palette_device &palette, bitmap_ind16 &dest, con
 	if (trans_pen > 0xff)
 		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_SPAN_CORE(UINT16, SPAN_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
 }
 
 void gfx_element::prio_transpen(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1197,26 +1337,24 @@ void gfx_element::prio_transpen(palette_device &palette, bitmap_rgb32 &dest, con
 	if (trans_pen > 0xff)
 		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_SPAN_CORE(UINT32, SPAN_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
 }
 
 
@@ -1232,7 +1370,7 @@ void gfx_element::prio_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 {
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1248,7 +1386,7 @@ void gfx_element::prio_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprec
 {
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1273,26 +1411,24 @@ void gfx_element::prio_transmask(palette_device &palette, bitmap_ind16 &dest, co
 	if (trans_mask == 0)
 		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	DRAWGFX_SPAN_CORE(UINT16, SPAN_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
 }
 
 void gfx_element::prio_transmask(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1303,26 +1439,24 @@ void gfx_element::prio_transmask(palette_device &palette, bitmap_rgb32 &dest, co
 	if (trans_mask == 0)
 		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
 
 	// render
 	const pen_t *paldata = &palette.pen(colorbase() + granularity() * (color % colors()));
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	DRAWGFX_SPAN_CORE(UINT32, SPAN_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
 }
 
 
@@ -1381,7 +1515,7 @@ void gfx_element::prio_alpha(palette_device &palette, bitmap_rgb32 &dest, const
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1458,19 +1592,17 @@ void gfx_element::prio_zoom_transpen(palette_device &palette, bitmap_ind16 &dest
 	if (trans_pen > 0xff)
 		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
@@ -1493,19 +1625,17 @@ void gfx_element::prio_zoom_transpen(palette_device &palette, bitmap_rgb32 &dest
 	if (trans_pen > 0xff)
 		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
+	gfx_opacity opacity = transpen_opacity(code, trans_pen);
 
-		// fully opaque; draw as such
-		if ((usage & (1 << trans_pen)) == 0)
-			return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
@@ -1534,7 +1664,7 @@ void gfx_element::prio_zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cl
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1555,7 +1685,7 @@ void gfx_element::prio_zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cl
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1586,19 +1716,17 @@ void gfx_element::prio_zoom_transmask(palette_device &palette, bitmap_ind16 &des
 	if (trans_mask == 0)
 		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
@@ -1621,19 +1749,17 @@ void gfx_element::prio_zoom_transmask(palette_device &palette, bitmap_rgb32 &des
 	if (trans_mask == 0)
 		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
-	// use pen usage to optimize
+	// use the decode-time classification to optimize
 	code %= elements();
-	if (has_pen_usage())
-	{
-		// fully transparent; do nothing
-		UINT32 usage = pen_usage(code);
-		if ((usage & ~trans_mask) == 0)
-			return;
+	gfx_opacity opacity = transmask_opacity(code, trans_mask);
 
-		// fully opaque; draw as such
-		if ((usage & trans_mask) == 0)
-			return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
-	}
+	// fully transparent; do nothing
+	if (opacity == GFX_OPACITY_TRANSPARENT)
+		return;
+
+	// fully opaque; draw as such
+	if (opacity == GFX_OPACITY_OPAQUE)
+		return prio_zoom_opaque(palette, dest, cliprect, code, color, flipx, flipy, destx, desty, scalex, scaley, priority, pmask);
 
 	// high bit of the mask is implicitly on
 	pmask |= 1 << 31;
@@ -1715,7 +1841,7 @@ void gfx_element::prio_zoom_alpha(palette_device &palette, bitmap_rgb32 &dest, c
 
 	// early out if completely transparent
 	code %= elements();
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << trans_pen)) == 0)
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	// high bit of the mask is implicitly on
@@ -1767,15 +1893,9 @@ void gfx_element::prio_transpen_additive(palette_device &palette, bitmap_rgb32 &
 	color %= colors();
 	paldata = &palette.pen(colorbase() + granularity() * color);
 
-	/* use pen usage to optimize */
-	if (has_pen_usage())
-	{
-		UINT32 usage = pen_usage(code);
-
-		/* fully transparent; do nothing */
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
-	}
+	/* fully transparent; do nothing */
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
+		return;
 
 	/* high bit of the mask is implicitly on */
 	pmask |= 1 << 31;
@@ -1808,15 +1928,9 @@ void gfx_element::prio_zoom_transpen_additive(palette_device &palette, bitmap_rg
 	color %= colors();
 	paldata = &palette.pen(colorbase() + granularity() * color);
 
-	/* use pen usage to optimize */
-	if (has_pen_usage())
-	{
-		UINT32 usage = pen_usage(code);
-
-		/* fully transparent; do nothing */
-		if ((usage & ~(1 << trans_pen)) == 0)
-			return;
-	}
+	/* fully transparent; do nothing */
+	if (transpen_opacity(code, trans_pen) == GFX_OPACITY_TRANSPARENT)
+		return;
 
 	/* high bit of the mask is implicitly on */
 	pmask |= 1 << 31;
@@ -1884,7 +1998,7 @@ void gfx_element::alphastore(palette_device &palette, bitmap_rgb32 &dest, const
 	paldata = &palette.pen(colorbase() + granularity() * color);
 
 	/* early out if completely transparent */
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << 0)) == 0)
+	if (transpen_opacity(code, 0) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	if (fixedalpha >= 0)
@@ -1927,7 +2041,7 @@ void gfx_element::alphatable(palette_device &palette, bitmap_rgb32 &dest, const
 	paldata = &palette.pen(colorbase() + granularity() * color);
 
 	/* early out if completely transparent */
-	if (has_pen_usage() && (pen_usage(code) & ~(1 << 0)) == 0)
+	if (transpen_opacity(code, 0) == GFX_OPACITY_TRANSPARENT)
 		return;
 
 	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANS0_ALPHATABLE32, NO_PRIORITY);
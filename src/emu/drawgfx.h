@@ -65,6 +65,14 @@ enum
 	DRAWMODE_SHADOW
 };
 
+// opacity of a whole element against a transparent pen or mask
+enum gfx_opacity
+{
+	GFX_OPACITY_MIXED,                  // some pixels may be transparent, some not
+	GFX_OPACITY_TRANSPARENT,            // every pixel is transparent
+	GFX_OPACITY_OPAQUE                  // no pixel is transparent
+};
+
 
 
 /***************************************************************************
@@ -181,6 +189,20 @@ public:
 		if (m_dirty[code]) decode(code);
 		return m_pen_usage[code];
 	}
+
+	// pre-flipped data where available; flipx and flipy are cleared when it is returned
+	const UINT8 *get_data(UINT32 code, int &flipx, int &flipy)
+	{
+		int orient = (flipx ? 1 : 0) | (flipy ? 2 : 0);
+		if (orient == 0 || !m_flipcache)
+			return get_data(code);
+		flipx = flipy = 0;
+		return get_flipped_data(code, orient);
+	}
+
+	// classification of a whole element against a transparent pen or mask of pens
+	gfx_opacity transpen_opacity(UINT32 code, UINT32 pen);
+	gfx_opacity transmask_opacity(UINT32 code, UINT32 mask);
 	
 	// ----- core graphics drawing -----
 
@@ -250,6 +272,9 @@ public:
 	void alphastore(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect,UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,int fixedalpha, UINT8 *alphatable);
 	void alphatable(palette_device &palette, bitmap_rgb32 &dest, const rectangle &cliprect, UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty, int fixedalpha ,UINT8 *alphatable);
 private:
+	// internal helpers
+	const UINT8 *get_flipped_data(UINT32 code, int orient);
+
 	// internal state
 	UINT16          m_width;                // current pixel width of each element (changeble with source clipping)
 	UINT16          m_height;               // current pixel height of each element (changeble with source clipping)
@@ -274,6 +299,10 @@ private:
 	dynamic_buffer  m_gfxdata_allocated;    // allocated decoded pixel data, 8bpp
 	dynamic_buffer  m_dirty;                // dirty array for detecting chars that need decoding
 	dynamic_array<UINT32> m_pen_usage;      // bitmask of pens that are used (pens 0-31 only)
+	dynamic_array<UINT16> m_pen_range;      // lowest (low byte) and highest (high byte) pen used, when there is no pen usage
+	bool            m_flipcache;            // keep pre-flipped copies of the decoded data?
+	dynamic_buffer  m_flipdata[3];          // X-, Y- and XY-flipped copies of the decoded data, built on demand
+	dynamic_buffer  m_flipdirty[3];         // dirty arrays for the flipped copies
 
 	bool            m_layout_is_raw;        // raw layout?
 	UINT8           m_layout_planes;        // bit planes in the layout
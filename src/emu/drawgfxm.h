@@ -53,6 +53,7 @@
 #define __DRAWGFXM_H__
 
 #include "profiler.h"
+#include "drawgfxs.h"
 
 
 /* special priority type meaning "none" */
@@ -313,6 +314,31 @@ do
 while (0)
 
 
+/***************************************************************************
+    SPAN OPERATIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    SPAN_OP_* - whole-row equivalents of the
+    PIXEL_OP_* macros of the same name, for use with
+    DRAWGFX_SPAN_CORE; see drawgfxs.h
+-------------------------------------------------*/
+
+#define SPAN_OP_REMAP_TRANSPEN(DEST, PRIORITY, SOURCE, STEP, COUNT)                 \
+	drawgfx_span(DEST, SOURCE, STEP, COUNT, paldata, drawgfx_span_transpen(trans_pen), drawgfx_span_copy())
+#define SPAN_OP_REMAP_TRANSPEN_PRIORITY(DEST, PRIORITY, SOURCE, STEP, COUNT)        \
+	drawgfx_span_priority(DEST, PRIORITY, SOURCE, STEP, COUNT, paldata, drawgfx_span_transpen(trans_pen), pmask)
+
+#define SPAN_OP_REMAP_TRANSMASK(DEST, PRIORITY, SOURCE, STEP, COUNT)                \
+	drawgfx_span(DEST, SOURCE, STEP, COUNT, paldata, drawgfx_span_transmask(trans_mask), drawgfx_span_copy())
+#define SPAN_OP_REMAP_TRANSMASK_PRIORITY(DEST, PRIORITY, SOURCE, STEP, COUNT)       \
+	drawgfx_span_priority(DEST, PRIORITY, SOURCE, STEP, COUNT, paldata, drawgfx_span_transmask(trans_mask), pmask)
+
+#define SPAN_OP_REMAP_TRANSPEN_ALPHA32(DEST, PRIORITY, SOURCE, STEP, COUNT)         \
+	drawgfx_span(DEST, SOURCE, STEP, COUNT, paldata, drawgfx_span_transpen(trans_pen), drawgfx_span_alpha(alpha_val))
+
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -386,6 +412,9 @@ do {
 		if (destendy > cliprect.max_y)                                                  \
 			destendy = cliprect.max_y;                                                  \
 																						\
+		/* fetch the source data, pre-flipped if possible (which clears flipx/flipy) */ \
+		srcdata = get_data(code, flipx, flipy);                                         \
+																						\
 		/* apply X flipping */                                                          \
 		if (flipx)                                                                      \
 			srcx = width() - 1 - srcx;                                             \
@@ -398,9 +427,6 @@ do {
 			dy = -dy;                                                                   \
 		}                                                                               \
 																						\
-		/* fetch the source data */                                                     \
-		srcdata = get_data(code);                                      \
-																						\
 		/* compute how many blocks of 4 pixels we have */                           \
 		UINT32 numblocks = (destendx + 1 - destx) / 4;                              \
 		UINT32 leftovers = (destendx + 1 - destx) - 4 * numblocks;                  \
@@ -483,6 +509,105 @@ do {
 
 
 
+/***************************************************************************
+    SPAN DRAWGFX CORE
+***************************************************************************/
+
+/*
+    Assumed input parameters or local variables are the same as for
+    DRAWGFX_CORE; SPAN_OP is one of the SPAN_OP* macros, and draws a
+    whole clipped row at a time.
+*/
+
+#define DRAWGFX_SPAN_CORE(PIXEL_TYPE, SPAN_OP, PRIORITY_TYPE)                           \
+do {                                                                                    \
+	g_profiler.start(PROFILER_DRAWGFX);                                                 \
+	do {                                                                                \
+		const UINT8 *srcdata;                                                           \
+		INT32 destendx, destendy;                                                       \
+		INT32 srcx, srcy;                                                               \
+		INT32 cury;                                                                     \
+		INT32 dy;                                                                       \
+																						\
+		assert(dest.valid());                                                           \
+		assert(!PRIORITY_VALID(PRIORITY_TYPE) || priority.valid());                     \
+		assert(dest.cliprect().contains(cliprect));                                     \
+		assert(code < elements());                                                      \
+																						\
+		/* ignore empty/invalid cliprects */                                            \
+		if (cliprect.empty())                                                           \
+			break;                                                                      \
+																						\
+		/* compute final pixel in X and exit if we are entirely clipped */              \
+		destendx = destx + width() - 1;                                                 \
+		if (destx > cliprect.max_x || destendx < cliprect.min_x)                        \
+			break;                                                                      \
+																						\
+		/* apply left clip */                                                           \
+		srcx = 0;                                                                       \
+		if (destx < cliprect.min_x)                                                     \
+		{                                                                               \
+			srcx = cliprect.min_x - destx;                                              \
+			destx = cliprect.min_x;                                                     \
+		}                                                                               \
+																						\
+		/* apply right clip */                                                          \
+		if (destendx > cliprect.max_x)                                                  \
+			destendx = cliprect.max_x;                                                  \
+																						\
+		/* compute final pixel in Y and exit if we are entirely clipped */              \
+		destendy = desty + height() - 1;                                                \
+		if (desty > cliprect.max_y || destendy < cliprect.min_y)                        \
+			break;                                                                      \
+																						\
+		/* apply top clip */                                                            \
+		srcy = 0;                                                                       \
+		if (desty < cliprect.min_y)                                                     \
+		{                                                                               \
+			srcy = cliprect.min_y - desty;                                              \
+			desty = cliprect.min_y;                                                     \
+		}                                                                               \
+																						\
+		/* apply bottom clip */                                                         \
+		if (destendy > cliprect.max_y)                                                  \
+			destendy = cliprect.max_y;                                                  \
+																						\
+		/* fetch the source data, pre-flipped if possible (which clears flipx/flipy) */ \
+		srcdata = get_data(code, flipx, flipy);                                         \
+																						\
+		/* apply X flipping */                                                          \
+		if (flipx)                                                                      \
+			srcx = width() - 1 - srcx;                                                  \
+																						\
+		/* apply Y flipping */                                                          \
+		dy = rowbytes();                                                                \
+		if (flipy)                                                                      \
+		{                                                                               \
+			srcy = height() - 1 - srcy;                                                 \
+			dy = -dy;                                                                   \
+		}                                                                               \
+																						\
+		/* adjust srcdata to point to the first source pixel of the row */              \
+		srcdata += srcy * rowbytes() + srcx;                                            \
+																						\
+		/* only the priority ops look at the priority bitmap */                         \
+		(void)priority;                                                                 \
+																						\
+		/* iterate over rows in Y, walking the source backwards if flipped in X */      \
+		UINT32 count = destendx + 1 - destx;                                            \
+		int step = flipx ? -1 : 1;                                                      \
+		for (cury = desty; cury <= destendy; cury++)                                    \
+		{                                                                               \
+			SPAN_OP(&dest.pixt<PIXEL_TYPE>(cury, destx),                                \
+					PRIORITY_ADDR(priority, PRIORITY_TYPE, cury, destx), srcdata, step, count); \
+			srcdata += dy;                                                              \
+		}                                                                               \
+	} while (0);                                                                        \
+	g_profiler.stop();                                                                  \
+} while (0)
+
+
+
 /***************************************************************************
     BASIC DRAWGFXZOOM CORE
 ***************************************************************************/
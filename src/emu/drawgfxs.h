@@ -0,0 +1,369 @@
+/*********************************************************************
+
+    drawgfxs.h
+
+    Span kernels used by the unzoomed drawgfx cores. Each kernel
+    classifies and draws 16 pixels per step using masks rather than
+    a branch per pixel.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+**********************************************************************
+
+    Only the handful of primitives at the top of this file depend on
+    the target; they are implemented with SSE2 on 64-bit x86, where
+    it can be assumed. Elsewhere the kernels fall back to a plain
+    per-pixel loop. A port to another vector unit only needs to
+    supply these primitives.
+
+    Palette lookups and priority mask tests are table lookups, and
+    stay scalar; the results are always bit-identical to the
+    equivalent PIXEL_OP* macros.
+
+*********************************************************************/
+
+#pragma once
+
+#ifndef __DRAWGFXS_H__
+#define __DRAWGFXS_H__
+
+/* use SSE2 on 64-bit implementations, where it can be assumed */
+#if (defined(__SSE2__) && defined(PTR64))
+#define DRAWGFX_SPAN_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/* number of pixels handled per step */
+#define DRAWGFX_SPAN_BLOCK      16
+
+
+
+/***************************************************************************
+    TARGET PRIMITIVES
+***************************************************************************/
+
+#ifdef DRAWGFX_SPAN_SSE2
+
+/*-------------------------------------------------
+    drawgfx_span_fetch - copy 16 source pens to
+    'pens', reversing them if step is negative
+-------------------------------------------------*/
+
+inline void drawgfx_span_fetch(UINT8 *pens, const UINT8 *src, int step)
+{
+	__m128i v;
+	if (step > 0)
+		v = _mm_loadu_si128((const __m128i *)src);
+	else
+	{
+		// reverse dwords, then words within dwords, then bytes within words
+		v = _mm_loadu_si128((const __m128i *)(src - 15));
+		v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3));
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	}
+	_mm_storeu_si128((__m128i *)pens, v);
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_match - return a bit per pen that
+    equals 'pen'
+-------------------------------------------------*/
+
+inline UINT32 drawgfx_span_match(const UINT8 *pens, UINT8 pen)
+{
+	__m128i v = _mm_loadu_si128((const __m128i *)pens);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(pen)));
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_match_any - return a bit per pen
+    that equals any of 'count' values once
+    masked with 'mask'
+-------------------------------------------------*/
+
+inline UINT32 drawgfx_span_match_any(const UINT8 *pens, const UINT8 *values, int count, UINT8 mask)
+{
+	__m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i *)pens), _mm_set1_epi8(mask));
+	__m128i result = _mm_setzero_si128();
+	for (int index = 0; index < count; index++)
+		result = _mm_or_si128(result, _mm_cmpeq_epi8(v, _mm_set1_epi8(values[index])));
+	return _mm_movemask_epi8(result);
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_select - store each color whose
+    bit is set in 'bits' to the destination
+-------------------------------------------------*/
+
+inline void drawgfx_span_select(UINT16 *dest, const UINT16 *colors, UINT32 bits)
+{
+	const __m128i lanes = _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+	for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index += 8, bits >>= 8)
+	{
+		__m128i mask = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(bits & 0xff), lanes), lanes);
+		__m128i d = _mm_loadu_si128((const __m128i *)&dest[index]);
+		__m128i s = _mm_loadu_si128((const __m128i *)&colors[index]);
+		_mm_storeu_si128((__m128i *)&dest[index], _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, d)));
+	}
+}
+
+inline void drawgfx_span_select(UINT32 *dest, const UINT32 *colors, UINT32 bits)
+{
+	const __m128i lanes = _mm_setr_epi32(0x01, 0x02, 0x04, 0x08);
+	for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index += 4, bits >>= 4)
+	{
+		__m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits & 0x0f), lanes), lanes);
+		__m128i d = _mm_loadu_si128((const __m128i *)&dest[index]);
+		__m128i s = _mm_loadu_si128((const __m128i *)&colors[index]);
+		_mm_storeu_si128((__m128i *)&dest[index], _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, d)));
+	}
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_uniform - return true if all 16
+    bytes are the same
+-------------------------------------------------*/
+
+inline bool drawgfx_span_uniform(const UINT8 *data)
+{
+	__m128i v = _mm_loadu_si128((const __m128i *)data);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(data[0]))) == 0xffff;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_mark - set each priority pixel
+    whose bit is set in 'bits' to 'value'
+-------------------------------------------------*/
+
+inline void drawgfx_span_mark(UINT8 *pri, UINT8 value, UINT32 bits)
+{
+	const __m128i lanes = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+	__m128i expanded = _mm_unpacklo_epi64(_mm_set1_epi8(bits & 0xff), _mm_set1_epi8((bits >> 8) & 0xff));
+	__m128i mask = _mm_cmpeq_epi8(_mm_and_si128(expanded, lanes), lanes);
+	__m128i d = _mm_loadu_si128((const __m128i *)pri);
+	_mm_storeu_si128((__m128i *)pri, _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi8(value)), _mm_andnot_si128(mask, d)));
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_blend - alpha blend each color
+    whose bit is set in 'bits' over the
+    destination, as alpha_blend_r32 does
+-------------------------------------------------*/
+
+inline void drawgfx_span_blend(UINT32 *dest, const UINT32 *colors, UINT32 bits, UINT8 level)
+{
+	const __m128i lanes = _mm_setr_epi32(0x01, 0x02, 0x04, 0x08);
+	const __m128i rgbmask = _mm_set1_epi32(0x00ffffff);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i slevel = _mm_set1_epi16(level);
+	const __m128i dlevel = _mm_set1_epi16(256 - level);
+	for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index += 4, bits >>= 4)
+	{
+		if ((bits & 0x0f) == 0)
+			continue;
+		__m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits & 0x0f), lanes), lanes);
+		__m128i d = _mm_loadu_si128((const __m128i *)&dest[index]);
+		__m128i s = _mm_loadu_si128((const __m128i *)&colors[index]);
+
+		// (s * level + d * (256 - level)) >> 8 per channel never exceeds 16 bits
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), slevel), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), dlevel));
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), slevel), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), dlevel));
+		__m128i result = _mm_and_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), rgbmask);
+		_mm_storeu_si128((__m128i *)&dest[index], _mm_or_si128(_mm_and_si128(mask, result), _mm_andnot_si128(mask, d)));
+	}
+}
+
+#endif
+
+
+
+/***************************************************************************
+    PEN CLASSIFIERS
+***************************************************************************/
+
+/* a single transparent pen; pens above 0xff are never transparent */
+struct drawgfx_span_transpen
+{
+	drawgfx_span_transpen(UINT32 pen) : m_pen(pen) { }
+	bool opaque(UINT8 pen) const { return pen != m_pen; }
+#ifdef DRAWGFX_SPAN_SSE2
+	UINT32 opaque_bits(const UINT8 *pens) const { return (m_pen > 0xff) ? 0xffff : (drawgfx_span_match(pens, m_pen) ^ 0xffff); }
+#endif
+	UINT32 m_pen;
+};
+
+/* a mask of transparent pens; like the shift in the scalar test, only the low 5 bits of a pen count */
+struct drawgfx_span_transmask
+{
+	drawgfx_span_transmask(UINT32 mask)
+		: m_mask(mask),
+			m_count(0)
+	{
+		for (int pen = 0; pen < 32 && m_count <= ARRAY_LENGTH(m_pens); pen++)
+			if ((mask >> pen) & 1)
+			{
+				if (m_count < ARRAY_LENGTH(m_pens))
+					m_pens[m_count] = pen;
+				m_count++;
+			}
+	}
+	bool opaque(UINT8 pen) const { return ((m_mask >> (pen & 0x1f)) & 1) == 0; }
+#ifdef DRAWGFX_SPAN_SSE2
+	UINT32 opaque_bits(const UINT8 *pens) const
+	{
+		// the usual handful of transparent pens can be compared directly
+		if (m_count <= ARRAY_LENGTH(m_pens))
+			return drawgfx_span_match_any(pens, m_pens, m_count, 0x1f) ^ 0xffff;
+		UINT32 bits = 0;
+		for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index++)
+			bits |= opaque(pens[index]) << index;
+		return bits;
+	}
+#endif
+	UINT32 m_mask;
+	UINT8 m_pens[4];
+	UINT32 m_count;
+};
+
+
+
+/***************************************************************************
+    PIXEL WRITERS
+***************************************************************************/
+
+/* replace the destination */
+struct drawgfx_span_copy
+{
+	template<typename _PixelType>
+	void pixel(_PixelType &dest, _PixelType color) const { dest = color; }
+
+#ifdef DRAWGFX_SPAN_SSE2
+	template<typename _PixelType>
+	void block(_PixelType *dest, const _PixelType *colors, UINT32 bits) const
+	{
+		if (bits == 0xffff)
+			memcpy(dest, colors, DRAWGFX_SPAN_BLOCK * sizeof(_PixelType));
+		else
+			drawgfx_span_select(dest, colors, bits);
+	}
+#endif
+};
+
+/* blend with the destination at a fixed alpha level */
+struct drawgfx_span_alpha
+{
+	drawgfx_span_alpha(UINT8 level) : m_level(level) { }
+	void pixel(UINT32 &dest, UINT32 color) const { dest = alpha_blend_r32(dest, color, m_level); }
+#ifdef DRAWGFX_SPAN_SSE2
+	void block(UINT32 *dest, const UINT32 *colors, UINT32 bits) const { drawgfx_span_blend(dest, colors, bits, m_level); }
+#endif
+	UINT8 m_level;
+};
+
+
+
+/***************************************************************************
+    SPAN KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drawgfx_span - draw 'count' remapped pixels
+    from 'src' (advancing by 'step') to 'dest'
+-------------------------------------------------*/
+
+template<typename _PixelType, class _Classifier, class _Writer>
+inline void drawgfx_span(_PixelType *dest, const UINT8 *src, int step, UINT32 count,
+		const pen_t *paldata, const _Classifier &classify, const _Writer &write)
+{
+#ifdef DRAWGFX_SPAN_SSE2
+	UINT8 pens[DRAWGFX_SPAN_BLOCK];
+	_PixelType colors[DRAWGFX_SPAN_BLOCK];
+
+	for ( ; count >= DRAWGFX_SPAN_BLOCK; count -= DRAWGFX_SPAN_BLOCK)
+	{
+		drawgfx_span_fetch(pens, src, step);
+		UINT32 opaque = classify.opaque_bits(pens);
+		if (opaque != 0)
+		{
+			for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index++)
+				colors[index] = paldata[pens[index]];
+			write.block(dest, colors, opaque);
+		}
+		src += step * DRAWGFX_SPAN_BLOCK;
+		dest += DRAWGFX_SPAN_BLOCK;
+	}
+#endif
+
+	// without a vector unit, this handles the whole span
+	for ( ; count > 0; count--, src += step, dest++)
+		if (classify.opaque(*src))
+			write.pixel(*dest, _PixelType(paldata[*src]));
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_priority - as drawgfx_span, but
+    only drawing pixels whose priority bit is clear
+    in 'pmask', and marking every opaque pixel in
+    the priority bitmap with 31
+-------------------------------------------------*/
+
+template<typename _PixelType, class _Classifier>
+inline void drawgfx_span_priority(_PixelType *dest, UINT8 *pri, const UINT8 *src, int step, UINT32 count,
+		const pen_t *paldata, const _Classifier &classify, UINT32 pmask)
+{
+#ifdef DRAWGFX_SPAN_SSE2
+	UINT8 pens[DRAWGFX_SPAN_BLOCK];
+	_PixelType colors[DRAWGFX_SPAN_BLOCK];
+	drawgfx_span_copy write;
+
+	for ( ; count >= DRAWGFX_SPAN_BLOCK; count -= DRAWGFX_SPAN_BLOCK)
+	{
+		drawgfx_span_fetch(pens, src, step);
+		UINT32 opaque = classify.opaque_bits(pens);
+		if (opaque != 0)
+		{
+			// priority bitmaps are mostly flat, so test a single value where we can
+			UINT32 visible = 0;
+			if (drawgfx_span_uniform(pri))
+				visible = (((1 << (pri[0] & 0x1f)) & pmask) == 0) ? 0xffff : 0;
+			else
+				for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index++)
+					visible |= (((1 << (pri[index] & 0x1f)) & pmask) == 0) << index;
+
+			if ((opaque & visible) != 0)
+			{
+				for (int index = 0; index < DRAWGFX_SPAN_BLOCK; index++)
+					colors[index] = paldata[pens[index]];
+				write.block(dest, colors, opaque & visible);
+			}
+			drawgfx_span_mark(pri, 31, opaque);
+		}
+		src += step * DRAWGFX_SPAN_BLOCK;
+		dest += DRAWGFX_SPAN_BLOCK;
+		pri += DRAWGFX_SPAN_BLOCK;
+	}
+#endif
+
+	// without a vector unit, this handles the whole span
+	for ( ; count > 0; count--, src += step, dest++, pri++)
+		if (classify.opaque(*src))
+		{
+			if (((1 << (*pri & 0x1f)) & pmask) == 0)
+				*dest = paldata[*src];
+			*pri = 31;
+		}
+}
+
+
+#endif  /* __DRAWGFXS_H__ */
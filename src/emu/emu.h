@@ -41,6 +41,7 @@
 #include "memory.h"
 #include "addrmap.h"
 #include "memarray.h"
+#include "memtrace.h"
 
 // machine-wide utilities
 #include "romload.h"
@@ -109,6 +110,7 @@ typedef device_t * (*machine_config_constructor)(machine_config &config, device_
 #include "video.h"
 
 // sound-related
+#include "resample.h"
 #include "sound.h"
 #include "speaker.h"
 
@@ -128,12 +128,14 @@ EMUOBJS = \
 	$(EMUOBJ)/mconfig.o \
 	$(EMUOBJ)/memarray.o \
 	$(EMUOBJ)/memory.o \
+	$(EMUOBJ)/memtrace.o \
 	$(EMUOBJ)/network.o \
 	$(EMUOBJ)/output.o \
 	$(EMUOBJ)/render.o \
 	$(EMUOBJ)/rendfont.o \
 	$(EMUOBJ)/rendlay.o \
 	$(EMUOBJ)/rendutil.o \
+	$(EMUOBJ)/resample.o \
 	$(EMUOBJ)/romload.o \
 	$(EMUOBJ)/save.o \
 	$(EMUOBJ)/schedule.o \
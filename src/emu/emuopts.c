@@ -58,10 +58,16 @@ const options_entry emu_options::s_option_entries[] =
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      NULL,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_STATE_DELTA,                                "0",         OPTION_BOOLEAN,    "save states as deltas against the last full state saved or loaded" },
+	{ OPTION_REWIND,                                     "0",         OPTION_INTEGER,    "number of in-memory states kept for rewinding (0 = disabled)" },
+	{ OPTION_REWIND_INTERVAL,                            "1",         OPTION_INTEGER,    "number of frames between rewind states" },
 	{ OPTION_PLAYBACK ";pb",                             NULL,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              NULL,        OPTION_STRING,     "record an input file" },
 	{ OPTION_MNGWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
+	{ OPTION_MFVWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a lossless MFV movie of the current session" },
+	{ OPTION_RECORD_QUEUE,                               "8",         OPTION_INTEGER,    "number of snapshot/movie frames that can wait for the encoder thread (0 = encode inline)" },
+	{ OPTION_RECORD_DROP,                                "0",         OPTION_BOOLEAN,    "drop movie frames instead of waiting when the encoder falls behind" },
 	{ OPTION_WAVWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a WAV file of the current session" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
@@ -78,6 +84,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_AUDIO_RATE_CONTROL ";arc",                  "0",         OPTION_BOOLEAN,    "adjusts the speed of gameplay by up to 0.5% to keep the sound buffer at a steady level" },
+	{ OPTION_GFX_FLIPCACHE,                              "1024",      OPTION_INTEGER,    "largest decoded gfx set, in KB, for which pre-flipped copies are kept (0 = disabled)" },
+	{ OPTION_TILEMAP_BANDS,                              "0",         OPTION_BOOLEAN,    "draw large tilemap layers in parallel horizontal bands" },
+	{ OPTION_TEXTURE_HASH,                               "1",         OPTION_BOOLEAN,    "hash render texture contents so unchanged textures are not rescaled or re-uploaded" },
 
 	// rotation options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE ROTATION OPTIONS" },
@@ -120,6 +130,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLER,                                  "fast",      OPTION_STRING,     "method for converting between sound chip and output rates (fast or sinc)" },
+	{ OPTION_SOUND_PARALLEL,                             "0",         OPTION_BOOLEAN,    "update independent sound chip streams concurrently" },
 
 	// input options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -159,6 +171,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_DEBUGSCRIPT,                                NULL,        OPTION_STRING,     "script for debugger" },
 	{ OPTION_DEBUG_INTERNAL ";di",                       "0",         OPTION_BOOLEAN,    "use the internal debugger for debugging" },
+	{ OPTION_SCHEDSTATS,                                 "0",         OPTION_BOOLEAN,    "display per-device scheduler statistics on exit" },
+	{ OPTION_MEMTRACE,                                   NULL,        OPTION_STRING,     "record memory accesses to the given binary trace file" },
+	{ OPTION_MEMTRACE_SPACES,                            NULL,        OPTION_STRING,     "comma-separated list of tag[.space] to trace (default: program space of every CPU)" },
 
 	// misc options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE MISC OPTIONS" },
@@ -70,10 +70,16 @@ enum
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
+#define OPTION_STATE_DELTA          "state_delta"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_INTERVAL      "rewind_interval"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
+#define OPTION_MFVWRITE             "mfvwrite"
+#define OPTION_RECORD_QUEUE         "record_queue"
+#define OPTION_RECORD_DROP          "record_drop"
 #define OPTION_WAVWRITE             "wavwrite"
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
@@ -89,6 +95,10 @@ enum
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_AUDIO_RATE_CONTROL   "audio_rate_control"
+#define OPTION_GFX_FLIPCACHE        "gfx_flipcache"
+#define OPTION_TILEMAP_BANDS        "tilemap_bands"
+#define OPTION_TEXTURE_HASH         "texture_hash"
 
 // core rotation options
 #define OPTION_ROTATE               "rotate"
@@ -126,6 +136,8 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLER            "resampler"
+#define OPTION_SOUND_PARALLEL       "sound_parallel"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -162,6 +174,9 @@ enum
 #define OPTION_DEBUG                "debug"
 #define OPTION_DEBUG_INTERNAL       "debug_internal"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_SCHEDSTATS           "schedstats"
+#define OPTION_MEMTRACE             "memtrace"
+#define OPTION_MEMTRACE_SPACES      "memtrace_spaces"
 
 // core misc options
 #define OPTION_DRC                  "drc"
@@ -238,10 +253,16 @@ public:
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	bool state_delta() const { return bool_value(OPTION_STATE_DELTA); }
+	int rewind() const { return int_value(OPTION_REWIND); }
+	int rewind_interval() const { return int_value(OPTION_REWIND_INTERVAL); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
+	const char *mfv_write() const { return value(OPTION_MFVWRITE); }
+	int record_queue() const { return int_value(OPTION_RECORD_QUEUE); }
+	bool record_drop() const { return bool_value(OPTION_RECORD_DROP); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
@@ -257,6 +278,10 @@ public:
 	bool sleep() const { return bool_value(OPTION_SLEEP); }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return bool_value(OPTION_REFRESHSPEED); }
+	bool audio_rate_control() const { return bool_value(OPTION_AUDIO_RATE_CONTROL); }
+	int gfx_flipcache() const { return int_value(OPTION_GFX_FLIPCACHE); }
+	bool tilemap_bands() const { return bool_value(OPTION_TILEMAP_BANDS); }
+	bool texture_hash() const { return bool_value(OPTION_TEXTURE_HASH); }
 
 	// core rotation options
 	bool rotate() const { return bool_value(OPTION_ROTATE); }
@@ -294,6 +319,8 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	const char *resampler() const { return value(OPTION_RESAMPLER); }
+	bool sound_parallel() const { return bool_value(OPTION_SOUND_PARALLEL); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -328,6 +355,9 @@ public:
 	bool debug_internal() const { return bool_value(OPTION_DEBUG_INTERNAL); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	bool sched_stats() const { return bool_value(OPTION_SCHEDSTATS); }
+	const char *memtrace() const { return value(OPTION_MEMTRACE); }
+	const char *memtrace_spaces() const { return value(OPTION_MEMTRACE_SPACES); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
@@ -143,6 +143,11 @@ running_machine::running_machine(const machine_config &_config, osd_interface &o
 		m_saveload_schedule(SLS_NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(NULL),
+		m_rewind(NULL),
+		m_rewind_frames(0),
+		m_rewind_capture(false),
+		m_rewind_pending(false),
+		m_memtrace(NULL),
 		m_logerror_list(m_respool),
 
 		m_save(*this),
@@ -278,6 +283,10 @@ void running_machine::start()
 	if ((debug_flags & DEBUG_FLAG_ENABLED) != 0)
 		debugger_init(*this);
 
+	// start recording memory accesses if requested
+	if (options().memtrace()[0] != 0)
+		m_memtrace = auto_alloc(*this, memtrace_manager(*this));
+
 	// call the game driver's init function
 	// this is where decryption is done and memory maps are altered
 	// so this location in the init order is important
@@ -286,6 +295,8 @@ void running_machine::start()
 	// register callbacks for the devices, then start them
 	add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(FUNC(running_machine::reset_all_devices), this));
 	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(running_machine::stop_all_devices), this));
+	if (options().sched_stats())
+		add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(device_scheduler::dump_stats), &m_scheduler));
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
 	start_all_devices();
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
@@ -310,6 +321,18 @@ void running_machine::start()
 
 	// disallow save state registrations starting here
 	m_save.allow_registration(false);
+
+	// now that the state layout is fixed, set up the rewind ring; every older
+	// state may need a worst-case delta, so make sure the total is addressable
+	int rewind = options().rewind();
+	if (rewind > 0 && m_save.state_size() > 0)
+	{
+		size_t slotmax = save_manager::delta_max_size(m_save.state_size()) + sizeof(dynamic_array<UINT8>);
+		if ((size_t)rewind > (size_t)~0 / slotmax)
+			throw emu_fatalerror("Rewind buffer of %d states of %u bytes is too large", rewind, m_save.state_size());
+		m_rewind = auto_alloc(*this, rewind_ring(m_save, rewind));
+		add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(running_machine::rewind_frame_update), this));
+	}
 }
 
 
@@ -394,6 +417,10 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// handle rewind capture/restore
+			if (m_rewind_capture || m_rewind_pending)
+				handle_rewind();
+
 			g_profiler.stop();
 		}
 
@@ -712,6 +739,18 @@ void running_machine::immediate_load(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_rewind - schedule a step back to the
+//  most recent rewind state
+//-------------------------------------------------
+
+void running_machine::schedule_rewind()
+{
+	if (m_rewind != NULL)
+		m_rewind_pending = true;
+}
+
+
 //-------------------------------------------------
 //  pause - pause the system
 //-------------------------------------------------
@@ -911,8 +950,18 @@ void running_machine::handle_saveload()
 	filerr = file.open(m_saveload_pending_file);
 	if (filerr == FILERR_NONE)
 	{
+		// with -state_delta, the last full state saved or loaded becomes the
+		// reference, and other saves are written as deltas against it
+		const char *refname = options().state_delta() ? m_saveload_pending_file.cstr() : NULL;
+
 		// read/write the save state
-		save_error saverr = (m_saveload_schedule == SLS_LOAD) ? m_save.read_file(file) : m_save.write_file(file);
+		save_error saverr;
+		if (m_saveload_schedule == SLS_LOAD)
+			saverr = m_save.read_file(file, refname, m_saveload_searchpath);
+		else if (refname != NULL && m_save.has_reference() && strcmp(m_save.reference_name(), refname) != 0)
+			saverr = m_save.write_delta_file(file);
+		else
+			saverr = m_save.write_file(file, refname);
 
 		// handle the result
 		switch (saverr)
@@ -933,6 +982,10 @@ void running_machine::handle_saveload()
 				popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
 				break;
 
+			case STATERR_REFERENCE_ERROR:
+				popmessage("Error: Unable to %s state because the full state it was saved against is missing or has changed.", opname);
+				break;
+
 			case STATERR_NONE:
 				if (!(m_system.flags & GAME_SUPPORTS_SAVE))
 					popmessage("State successfully %s.\nWarning: Save states are not officially supported for this game.", opnamed);
@@ -960,6 +1013,45 @@ cancel:
 }
 
 
+//-------------------------------------------------
+//  rewind_frame_update - count down to the next
+//  rewind capture
+//-------------------------------------------------
+
+void running_machine::rewind_frame_update()
+{
+	if (!m_paused && --m_rewind_frames <= 0)
+	{
+		m_rewind_frames = MAX(options().rewind_interval(), 1);
+		m_rewind_capture = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  handle_rewind - capture or restore a rewind
+//  state between timeslices
+//-------------------------------------------------
+
+void running_machine::handle_rewind()
+{
+	// like save states, we can't snapshot around anonymous timers; try again next slice
+	if (!m_scheduler.can_save())
+		return;
+
+	// a step back wins over a capture due in the same timeslice
+	if (m_rewind_pending)
+	{
+		if (m_rewind->step_back() != STATERR_NONE)
+			popmessage("No rewind states left");
+	}
+	else
+		m_rewind->capture();
+
+	m_rewind_capture = m_rewind_pending = false;
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
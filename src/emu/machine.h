@@ -213,6 +213,8 @@ public:
 	const char *basename() const { return m_basename; }
 	int sample_rate() const { return m_sample_rate; }
 	bool save_or_load_pending() const { return m_saveload_pending_file; }
+	rewind_ring *rewinder() const { return m_rewind; }
+	memtrace_manager *memtrace() const { return m_memtrace; }
 	screen_device *first_screen() const { return primary_screen; }
 
 	// additional helpers
@@ -248,6 +250,7 @@ public:
 	void schedule_new_driver(const game_driver &driver);
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_rewind();
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -285,6 +288,8 @@ private:
 	astring get_statename(const char *statename_opt);
 	void fill_systime(system_time &systime, time_t t);
 	void handle_saveload();
+	void handle_rewind();
+	void rewind_frame_update();
 	void soft_reset(void *ptr = NULL, INT32 param = 0);
 	void watchdog_fired(void *ptr = NULL, INT32 param = 0);
 	void watchdog_vblank(screen_device &screen, bool vblank_state);
@@ -355,6 +360,15 @@ private:
 	astring                 m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	// rewind management
+	rewind_ring *           m_rewind;               // ring of in-memory states, or NULL
+	int                     m_rewind_frames;        // frames left until the next capture
+	bool                    m_rewind_capture;       // capture due at the end of this timeslice
+	bool                    m_rewind_pending;       // step back at the end of this timeslice
+
+	// memory access tracing
+	memtrace_manager *      m_memtrace;             // access trace recorder, or NULL
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
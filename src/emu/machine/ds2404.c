@@ -100,7 +100,9 @@ void ds2404_device::device_start()
 	for (int i = 0; i < 8; i++)
 		m_state[i] = DS2404_STATE_IDLE;
 
+	// nothing sees the counter between reads, so let the ticks batch up
 	m_tick_timer = timer_alloc(0);
+	m_tick_timer->set_batch(128);
 	m_tick_timer->adjust(attotime::from_hz(256), 0, attotime::from_hz(256));
 }
 
@@ -163,6 +165,7 @@ UINT8 ds2404_device::ds2404_readmem()
 	}
 	else if( m_address >= 0x202 && m_address <= 0x206 )
 	{
+		m_tick_timer->catch_up();
 		return m_rtc[ m_address - 0x202 ];
 	}
 	return 0;
@@ -176,6 +179,7 @@ void ds2404_device::ds2404_writemem(UINT8 value)
 	}
 	else if( m_address >= 0x202 && m_address <= 0x206 )
 	{
+		m_tick_timer->catch_up();
 		m_rtc[ m_address - 0x202 ] = value;
 	}
 }
@@ -352,14 +356,13 @@ void ds2404_device::device_timer(emu_timer &timer, device_timer_id id, int param
 	{
 		case 0:
 		{
-			// tick
-			for(int i = 0; i < 5; i++)
+			// tick, once for each period the timer batched up
+			UINT32 carry = timer.periods();
+			for(int i = 0; i < 5 && carry != 0; i++)
 			{
-				m_rtc[ i ]++;
-				if(m_rtc[ i ] != 0)
-				{
-					break;
-				}
+				carry += m_rtc[ i ];
+				m_rtc[ i ] = carry & 0xff;
+				carry >>= 8;
 			}
 
 			break;
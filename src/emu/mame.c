@@ -135,7 +135,7 @@ int mame_is_valid_machine(running_machine &machine)
     mame_execute - run the core emulation
 -------------------------------------------------*/
 
-int mame_execute(emu_options &options, osd_interface &osd)
+int mame_execute(emu_options &options, osd_interface &osd, machine_finished_delegate finished)
 {
 	bool firstgame = true;
 	bool firstrun = true;
@@ -192,6 +192,10 @@ int mame_execute(emu_options &options, osd_interface &osd)
 		error = machine.run(firstrun);
 		firstrun = false;
 
+		// let the caller look at the machine before it is torn down
+		if (!finished.isnull())
+			finished(machine, error);
+
 		// check the state of the machine
 		if (machine.new_driver_pending())
 		{
@@ -51,6 +51,9 @@ enum
 // output channel callback
 typedef delegate<void (const char *, va_list)> output_delegate;
 
+// callback with a machine that has finished running, and its result code
+typedef delegate<void (running_machine &, int)> machine_finished_delegate;
+
 class emulator_info
 {
 public:
@@ -94,7 +97,7 @@ extern const char build_version[];
 /* ----- core system management ----- */
 
 /* execute as configured by the OPTION_SYSTEMNAME option on the specified options */
-int mame_execute(emu_options &options, osd_interface &osd);
+int mame_execute(emu_options &options, osd_interface &osd, machine_finished_delegate finished = machine_finished_delegate());
 
 
 
@@ -758,7 +758,8 @@ private:
 	template<typename _UintType>
 	_UintType watchpoint_r(address_space &space, offs_t offset, _UintType mask)
 	{
-		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
+		if (m_space.device().debug() != NULL)
+			m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
@@ -768,6 +769,10 @@ private:
 		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
 		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
 		m_live_lookup = oldtable;
+
+		// record the access once we know what was read
+		if (m_space.trace() != NULL && !m_space.debugger_access())
+			m_space.trace()->record(false, offset * sizeof(_UintType), result, mask);
 		return result;
 	}
 
@@ -826,7 +831,10 @@ private:
 	template<typename _UintType>
 	void watchpoint_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
 	{
-		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
+		if (m_space.device().debug() != NULL)
+			m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
+		if (m_space.trace() != NULL && !m_space.debugger_access())
+			m_space.trace()->record(true, offset * sizeof(_UintType), data, mask);
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
@@ -1065,8 +1073,8 @@ public:
 	virtual address_table_setoffset &setoffset() { return m_setoffset; }
 
 	// watchpoint control
-	virtual void enable_read_watchpoints(bool enable = true) { m_read.enable_watchpoints(enable); }
-	virtual void enable_write_watchpoints(bool enable = true) { m_write.enable_watchpoints(enable); }
+	virtual void enable_read_watchpoints(bool enable = true) { m_read.enable_watchpoints(enable || m_trace != NULL); }
+	virtual void enable_write_watchpoints(bool enable = true) { m_write.enable_watchpoints(enable || m_trace != NULL); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const
@@ -1732,6 +1740,7 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_spacenum(spacenum),
 		m_debugger_access(false),
 		m_log_unmap(true),
+		m_trace(NULL),
 		m_direct(*auto_alloc(memory.device().machine(), direct_read_data(*this))),
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.m_addrbus_width + 3) / 4),
@@ -2288,6 +2297,24 @@ const char *address_space::get_handler_string(read_or_write readorwrite, offs_t
 }
 
 
+//-------------------------------------------------
+//  set_trace - attach or detach an access trace
+//  recorder; while one is attached, the
+//  watchpoint handlers stay live so that every
+//  access is seen
+//-------------------------------------------------
+
+void address_space::set_trace(memtrace_space *trace)
+{
+	m_trace = trace;
+	if (m_trace != NULL)
+	{
+		enable_read_watchpoints();
+		enable_write_watchpoints();
+	}
+}
+
+
 //-------------------------------------------------
 //  dump_map - dump the contents of a single
 //  address space
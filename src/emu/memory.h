@@ -73,6 +73,7 @@ class address_table;
 class address_table_read;
 class address_table_write;
 class address_table_setoffset;
+class memtrace_space;
 
 
 // offsets and addresses are 32-bit (for now...)
@@ -325,6 +326,10 @@ public:
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
 
+	// access tracing; a traced space routes accesses through the watchpoint handlers
+	memtrace_space *trace() const { return m_trace; }
+	void set_trace(memtrace_space *trace);
+
 	// watchpoint enablers
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
@@ -552,6 +557,7 @@ protected:
 	address_spacenum        m_spacenum;         // address space index
 	bool                    m_debugger_access;  // treat accesses as coming from the debugger
 	bool                    m_log_unmap;        // log unmapped accesses in this space?
+	memtrace_space *        m_trace;            // access trace recorder, or NULL
 	direct_read_data &      m_direct;           // fast direct-access read info
 	const char *            m_name;             // friendly name of the address space
 	UINT8                   m_addrchars;        // number of characters to use for physical addresses
@@ -0,0 +1,438 @@
+/***************************************************************************
+
+    memtrace.c
+
+    Binary recorder for the memory accesses made on selected address
+    spaces.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    Accesses are captured in the watchpoint handlers of each traced
+    space, so the full debugger is not needed. Opcode fetches through
+    the direct access path are not seen, just as with watchpoints.
+
+    Each space has its own ring of fixed-size entries. The emulation
+    side fills the ring and hands batches to a writer running on an
+    I/O work queue, which encodes them compactly and writes them out.
+    If the writer falls a whole ring behind, the emulation waits for
+    it rather than dropping accesses.
+
+    File layout (all values little-endian):
+
+        8 bytes    magic "MAMETRC\0"
+        4 bytes    format version
+        4 bytes    number of spaces
+        per space:
+            1 byte     data width in bytes
+            1 byte     number of hex digits in a logical address
+            1 byte     length of the name
+            N bytes    name, as "<device tag>.<space name>"
+
+    followed by records until the end of the file:
+
+        1 byte     space index in the low 4 bits, plus MEMTRACE_FLAG_*
+        varint     cycle delta from the previous record in this space (zigzag)
+        varint     address delta from the previous record in this space (zigzag)
+        varint     data
+        varint     mask, only if MEMTRACE_FLAG_MASK is set
+        varint     PC delta from the previous record in this space (zigzag),
+                   only if MEMTRACE_FLAG_SAME_PC is clear
+
+    Varints are 7 bits per byte, least significant group first, with
+    the top bit set on every byte but the last. Deltas start from zero.
+    Records of one space are in order; records of different spaces are
+    interleaved in batches.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+
+
+
+//**************************************************************************
+//  INLINE HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  put_varint - append a 7-bits-per-byte
+//  variable length value
+//-------------------------------------------------
+
+inline UINT8 *put_varint(UINT8 *dest, UINT64 value)
+{
+	while (value >= 0x80)
+	{
+		*dest++ = UINT8(value) | 0x80;
+		value >>= 7;
+	}
+	*dest++ = UINT8(value);
+	return dest;
+}
+
+
+//-------------------------------------------------
+//  zigzag - fold a signed delta so that small
+//  magnitudes of either sign encode compactly
+//-------------------------------------------------
+
+inline UINT64 zigzag(INT64 value)
+{
+	return (UINT64(value) << 1) ^ UINT64(value >> 63);
+}
+
+
+
+//**************************************************************************
+//  MEMTRACE SPACE
+//**************************************************************************
+
+//-------------------------------------------------
+//  memtrace_space - constructor
+//-------------------------------------------------
+
+memtrace_space::memtrace_space(memtrace_manager &manager, address_space &space, int index)
+	: m_next(NULL),
+		m_manager(manager),
+		m_space(space),
+		m_execute(NULL),
+		m_state(NULL),
+		m_index(index),
+		m_fullmask(~U64(0) >> (64 - space.data_width())),
+		m_ring(RING_SIZE),
+		m_head(0),
+		m_published(0),
+		m_tail(0),
+		m_count(0),
+		m_last_cycles(0),
+		m_last_address(0),
+		m_last_pc(0)
+{
+	// timestamp and attribute accesses using the space's own device where possible
+	space.device().interface(m_execute);
+	space.device().interface(m_state);
+}
+
+
+//-------------------------------------------------
+//  record - capture a single access; called from
+//  the watchpoint handlers
+//-------------------------------------------------
+
+void memtrace_space::record(bool write, offs_t byteaddress, UINT64 data, UINT64 mask)
+{
+	// if the writer is a whole ring behind, wait for it
+	if (m_head - UINT32(m_tail) >= RING_SIZE)
+		m_manager.wait_for_writer(*this);
+
+	entry &cur = m_ring[m_head & (RING_SIZE - 1)];
+	cur.m_cycles = (m_execute != NULL) ? m_execute->total_cycles() : 0;
+	cur.m_data = data;
+	cur.m_mask = mask;
+	cur.m_address = m_space.byte_to_address(byteaddress);
+	cur.m_pc = (m_state != NULL) ? m_state->pcbase() : 0;
+	cur.m_write = write;
+	m_count++;
+
+	// hand over a batch every so often
+	if ((++m_head & (PUBLISH_INTERVAL - 1)) == 0)
+		m_manager.publish(*this);
+}
+
+
+
+//**************************************************************************
+//  MEMTRACE MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  memtrace_manager - constructor
+//-------------------------------------------------
+
+memtrace_manager::memtrace_manager(running_machine &machine)
+	: m_machine(machine),
+		m_spaces(machine.respool()),
+		m_file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
+		m_queue(NULL),
+		m_kicked(0),
+		m_buffer(BUFFER_SIZE),
+		m_buffer_used(0),
+		m_bytes(0),
+		m_stalls(0)
+{
+	// pick the spaces: either those listed, or the program space of every CPU
+	const char *spaces = machine.options().memtrace_spaces();
+	if (spaces[0] != 0)
+	{
+		astring list(spaces);
+		for (int start = 0, end; start < list.len(); start = end + 1)
+		{
+			end = list.chr(start, ',');
+			if (end == -1)
+				end = list.len();
+			astring spec(list, start, end - start);
+			spec.trimspace();
+			if (spec.len() == 0)
+				continue;
+
+			// split off the optional space name
+			astring tag(spec), spacename("program");
+			int dot = spec.chr(0, '.');
+			if (dot != -1)
+			{
+				tag.cpysubstr(spec, 0, dot);
+				spacename.cpysubstr(spec, dot + 1);
+			}
+
+			// find the device and the space
+			device_t *device = machine.device(tag);
+			device_memory_interface *memory;
+			if (device == NULL || !device->interface(memory))
+				throw emu_fatalerror("memtrace: '%s' is not a device with memory", tag.cstr());
+			int spacenum;
+			for (spacenum = 0; spacenum < ADDRESS_SPACES; spacenum++)
+				if (memory->has_space(spacenum) && spacename == memory->space(spacenum).name())
+					break;
+			if (spacenum == ADDRESS_SPACES)
+				throw emu_fatalerror("memtrace: device '%s' has no '%s' space", tag.cstr(), spacename.cstr());
+			add_space(memory->space(spacenum));
+		}
+	}
+	else
+	{
+		execute_interface_iterator iter(machine.root_device());
+		for (device_execute_interface *exec = iter.first(); exec != NULL; exec = iter.next())
+		{
+			device_memory_interface *memory;
+			if (exec->device().interface(memory) && memory->has_space(AS_PROGRAM))
+				add_space(memory->space(AS_PROGRAM));
+		}
+	}
+
+	// open the output and write the space table
+	file_error filerr = m_file.open(machine.options().memtrace());
+	if (filerr != FILERR_NONE)
+		throw emu_fatalerror("memtrace: unable to open '%s' for writing", machine.options().memtrace());
+	write_header();
+
+	// create the writer and hook into the spaces
+	m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_queue == NULL)
+		throw emu_fatalerror("memtrace: unable to create the writer queue");
+	for (memtrace_space *space = m_spaces.first(); space != NULL; space = space->next())
+		space->space().set_trace(space);
+
+	// flush everything on the way out
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memtrace_manager::exit), this));
+}
+
+
+//-------------------------------------------------
+//  ~memtrace_manager - destructor
+//-------------------------------------------------
+
+memtrace_manager::~memtrace_manager()
+{
+	if (m_queue != NULL)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  add_space - add a space to the list of those
+//  being traced
+//-------------------------------------------------
+
+void memtrace_manager::add_space(address_space &space)
+{
+	// ignore duplicates
+	for (memtrace_space *existing = m_spaces.first(); existing != NULL; existing = existing->next())
+		if (&existing->space() == &space)
+			return;
+
+	int index = m_spaces.count();
+	if (index >= MEMTRACE_MAX_SPACES)
+		throw emu_fatalerror("memtrace: at most %d spaces can be traced", MEMTRACE_MAX_SPACES);
+	m_spaces.append(*auto_alloc(machine(), memtrace_space(*this, space, index)));
+}
+
+
+//-------------------------------------------------
+//  write_header - write the file header and the
+//  table of traced spaces
+//-------------------------------------------------
+
+void memtrace_manager::write_header()
+{
+	UINT8 header[16];
+	memcpy(&header[0], MEMTRACE_MAGIC, 8);
+	header[8] = MEMTRACE_VERSION;
+	header[9] = MEMTRACE_VERSION >> 8;
+	header[10] = MEMTRACE_VERSION >> 16;
+	header[11] = MEMTRACE_VERSION >> 24;
+	header[12] = m_spaces.count();
+	header[13] = header[14] = header[15] = 0;
+	m_file.write(header, sizeof(header));
+	m_bytes += sizeof(header);
+
+	for (memtrace_space *space = m_spaces.first(); space != NULL; space = space->next())
+	{
+		address_space &as = space->space();
+		astring name;
+		name.printf("%s.%s", as.device().tag() + 1, as.name());
+
+		UINT8 info[3];
+		info[0] = as.data_width() / 8;
+		info[1] = as.logaddrchars();
+		info[2] = MIN(name.len(), 255);
+		m_file.write(info, sizeof(info));
+		m_file.write(name.cstr(), info[2]);
+		m_bytes += sizeof(info) + info[2];
+	}
+}
+
+
+//-------------------------------------------------
+//  exit - detach from the spaces and write out
+//  everything still pending
+//-------------------------------------------------
+
+void memtrace_manager::exit()
+{
+	UINT64 accesses = 0;
+	for (memtrace_space *space = m_spaces.first(); space != NULL; space = space->next())
+	{
+		space->space().set_trace(NULL);
+		atomic_exchange32(&space->m_published, space->m_head);
+		accesses += space->count();
+	}
+
+	// run a final pass and wait for it
+	atomic_exchange32(&m_kicked, 1);
+	osd_work_item_queue(m_queue, writer_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+	m_file.close();
+
+	mame_printf_verbose("memtrace: %" I64FMT "d accesses in %" I64FMT "d bytes written to %s, %d writer stalls\n", accesses, m_bytes, machine().options().memtrace(), m_stalls);
+}
+
+
+//-------------------------------------------------
+//  publish - make a space's entries visible to
+//  the writer and make sure a pass is queued
+//-------------------------------------------------
+
+void memtrace_manager::publish(memtrace_space &space)
+{
+	atomic_exchange32(&space.m_published, space.m_head);
+	if (atomic_exchange32(&m_kicked, 1) == 0)
+		osd_work_item_queue(m_queue, writer_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  wait_for_writer - called by a producer whose
+//  ring is full; blocks until there is room
+//-------------------------------------------------
+
+void memtrace_manager::wait_for_writer(memtrace_space &space)
+{
+	m_stalls++;
+	publish(space);
+	while (space.m_head - UINT32(space.m_tail) >= memtrace_space::RING_SIZE)
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() / 100);
+}
+
+
+//-------------------------------------------------
+//  writer_callback - work queue entry point for
+//  a writer pass
+//-------------------------------------------------
+
+void *memtrace_manager::writer_callback(void *param, int threadid)
+{
+	reinterpret_cast<memtrace_manager *>(param)->drain();
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  drain - encode and write everything that has
+//  been published so far
+//-------------------------------------------------
+
+void memtrace_manager::drain()
+{
+	// clear the kick first, so anything published after this point queues another pass
+	atomic_exchange32(&m_kicked, 0);
+
+	for (memtrace_space *space = m_spaces.first(); space != NULL; space = space->next())
+	{
+		UINT32 head = space->m_published;
+		UINT32 tail = space->m_tail;
+		while (tail != head)
+		{
+			encode(*space, space->m_ring[tail++ & (memtrace_space::RING_SIZE - 1)]);
+			if (m_buffer_used > BUFFER_SIZE - MAX_RECORD_SIZE)
+				flush_buffer();
+
+			// give back room as we go so a waiting producer can resume
+			if ((tail & (memtrace_space::PUBLISH_INTERVAL - 1)) == 0)
+				atomic_exchange32(&space->m_tail, tail);
+		}
+		atomic_exchange32(&space->m_tail, tail);
+	}
+	flush_buffer();
+}
+
+
+//-------------------------------------------------
+//  encode - append a compact record for a single
+//  entry to the output buffer
+//-------------------------------------------------
+
+void memtrace_manager::encode(memtrace_space &space, const memtrace_space::entry &entry)
+{
+	UINT8 *base = &m_buffer[m_buffer_used];
+	UINT8 *dest = base + 1;
+
+	UINT8 flags = space.m_index;
+	if (entry.m_write)
+		flags |= MEMTRACE_FLAG_WRITE;
+
+	dest = put_varint(dest, zigzag(entry.m_cycles - space.m_last_cycles));
+	dest = put_varint(dest, zigzag(INT32(entry.m_address - space.m_last_address)));
+	dest = put_varint(dest, entry.m_data);
+	if (entry.m_mask != space.m_fullmask)
+	{
+		flags |= MEMTRACE_FLAG_MASK;
+		dest = put_varint(dest, entry.m_mask);
+	}
+	if (entry.m_pc == space.m_last_pc)
+		flags |= MEMTRACE_FLAG_SAME_PC;
+	else
+		dest = put_varint(dest, zigzag(INT32(entry.m_pc - space.m_last_pc)));
+	*base = flags;
+
+	space.m_last_cycles = entry.m_cycles;
+	space.m_last_address = entry.m_address;
+	space.m_last_pc = entry.m_pc;
+	m_buffer_used = dest - &m_buffer[0];
+}
+
+
+//-------------------------------------------------
+//  flush_buffer - write out the encoded buffer
+//-------------------------------------------------
+
+void memtrace_manager::flush_buffer()
+{
+	if (m_buffer_used == 0)
+		return;
+	m_file.write(&m_buffer[0], m_buffer_used);
+	m_bytes += m_buffer_used;
+	m_buffer_used = 0;
+}
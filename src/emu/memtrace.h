@@ -0,0 +1,151 @@
+/***************************************************************************
+
+    memtrace.h
+
+    Binary recorder for the memory accesses made on selected address
+    spaces.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef __MEMTRACE_H__
+#define __MEMTRACE_H__
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// file format identification; see memtrace.c for the layout
+#define MEMTRACE_MAGIC          "MAMETRC"
+const UINT32 MEMTRACE_VERSION = 1;
+
+// flag bits in the first byte of each record; the low bits hold the space index
+const UINT8 MEMTRACE_SPACE_MASK = 0x0f;
+const UINT8 MEMTRACE_FLAG_WRITE = 0x10;         // access was a write
+const UINT8 MEMTRACE_FLAG_MASK = 0x20;          // a partial mask follows the data
+const UINT8 MEMTRACE_FLAG_SAME_PC = 0x40;       // PC is unchanged from the previous record
+const int MEMTRACE_MAX_SPACES = MEMTRACE_SPACE_MASK + 1;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class memtrace_manager;
+class device_execute_interface;
+class device_state_interface;
+
+
+// ======================> memtrace_space
+
+// a ring of pending accesses for a single address space; the thread
+// executing the space's accesses is the only producer and the writer
+// thread is the only consumer, so no locks are needed
+class memtrace_space
+{
+	friend class memtrace_manager;
+	friend class simple_list<memtrace_space>;
+
+public:
+	// construction/destruction
+	memtrace_space(memtrace_manager &manager, address_space &space, int index);
+
+	// getters
+	memtrace_space *next() const { return m_next; }
+	address_space &space() const { return m_space; }
+	UINT64 count() const { return m_count; }
+
+	// recording
+	void record(bool write, offs_t byteaddress, UINT64 data, UINT64 mask);
+
+private:
+	// a single access as captured on the emulation side
+	struct entry
+	{
+		UINT64              m_cycles;       // total cycles of the space's device
+		UINT64              m_data;         // data read or written
+		UINT64              m_mask;         // mask of the access
+		offs_t              m_address;      // logical address
+		offs_t              m_pc;           // PC of the space's device
+		bool                m_write;        // true for writes
+	};
+
+	static const UINT32 RING_SIZE = 65536;          // entries in the ring; must be a power of 2
+	static const UINT32 PUBLISH_INTERVAL = 1024;    // entries between hand-offs to the writer
+
+	// internal state
+	memtrace_space *        m_next;         // next space in the list
+	memtrace_manager &      m_manager;      // reference to our manager
+	address_space &         m_space;        // the space being traced
+	device_execute_interface *m_execute;    // device whose cycles timestamp the accesses, or NULL
+	device_state_interface *m_state;        // device whose PC is recorded, or NULL
+	int                     m_index;        // index of the space in the file
+	UINT64                  m_fullmask;     // mask of a full-width access
+	dynamic_array<entry>    m_ring;         // ring of pending entries
+	UINT32                  m_head;         // next entry to fill; producer only
+	volatile INT32          m_published;    // entries handed to the writer
+	volatile INT32          m_tail;         // next entry to consume; writer only
+	UINT64                  m_count;        // total accesses recorded
+
+	// delta encoding state, owned by the writer
+	UINT64                  m_last_cycles;  // cycles of the previous record
+	offs_t                  m_last_address; // address of the previous record
+	offs_t                  m_last_pc;      // PC of the previous record
+};
+
+
+// ======================> memtrace_manager
+
+// owns the traced spaces, the output file and the writer thread
+class memtrace_manager
+{
+	friend class memtrace_space;
+
+public:
+	// construction/destruction
+	memtrace_manager(running_machine &machine);
+	~memtrace_manager();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	memtrace_space *first_space() const { return m_spaces.first(); }
+
+private:
+	// internal helpers
+	void add_space(address_space &space);
+	void write_header();
+	void exit();
+	void publish(memtrace_space &space);
+	void wait_for_writer(memtrace_space &space);
+	static void *writer_callback(void *param, int threadid);
+	void drain();
+	void encode(memtrace_space &space, const memtrace_space::entry &entry);
+	void flush_buffer();
+
+	static const UINT32 BUFFER_SIZE = 65536;        // bytes of encoded output buffered per write
+	static const UINT32 MAX_RECORD_SIZE = 48;       // worst-case size of an encoded record
+
+	// internal state
+	running_machine &       m_machine;      // reference to our machine
+	simple_list<memtrace_space> m_spaces;   // list of traced spaces
+	emu_file                m_file;         // output file
+	osd_work_queue *        m_queue;        // queue for the writer thread
+	volatile INT32          m_kicked;       // non-zero while a writer pass is queued
+	dynamic_array<UINT8>    m_buffer;       // encoded output; writer only
+	UINT32                  m_buffer_used;  // bytes used in the buffer
+	UINT64                  m_bytes;        // total bytes written
+	UINT32                  m_stalls;       // times a producer waited for the writer
+};
+
+
+#endif  /* __MEMTRACE_H__ */
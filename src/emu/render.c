@@ -336,7 +336,11 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(NULL),
 		m_param(NULL),
-		m_curseq(0)
+		m_curseq(0),
+		m_hashed(false),
+		m_hash(0),
+		m_hashseq(0),
+		m_hashbcg(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
@@ -392,6 +396,8 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_hashed = false;
+	m_hashbcg = 0;
 }
 
 
@@ -407,6 +413,16 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (format == TEXFORMAT_PALETTE16 || format == TEXFORMAT_PALETTEA16)
 		assert(bitmap.palette() != NULL);
 
+	// direct color sources can be hashed; if the same bitmap comes back with
+	// the same content, keep the scaled versions and the sequence number
+	bool hashable = m_manager->texture_hash() && format != TEXFORMAT_PALETTE16 && format != TEXFORMAT_PALETTEA16;
+	UINT64 hash = hashable ? content_hash(bitmap, sbounds) : 0;
+	if (hashable && m_hashed && hash == m_hash && &bitmap == m_bitmap && sbounds == m_sbounds && format == m_format)
+		return;
+	m_hashed = hashable;
+	m_hash = hash;
+	m_hashseq = ++m_curseq;
+
 	// invalidate references to the old bitmap
 	if (&bitmap != m_bitmap && m_bitmap != NULL)
 		m_manager->invalidate_all(m_bitmap);
@@ -430,6 +446,58 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 }
 
 
+//-------------------------------------------------
+//  content_hash - compute a fast 64-bit hash of
+//  the pixels within the source bounds
+//-------------------------------------------------
+
+inline UINT64 content_hash_round(UINT64 acc, UINT64 input)
+{
+	acc += input * U64(0xc2b2ae3d27d4eb4f);
+	acc = (acc << 31) | (acc >> 33);
+	return acc * U64(0x9e3779b185ebca87);
+}
+
+inline UINT64 content_hash_read(const UINT8 *src)
+{
+	UINT64 result;
+	memcpy(&result, src, sizeof(result));
+	return result;
+}
+
+UINT64 render_texture::content_hash(bitmap_t &bitmap, const rectangle &sbounds)
+{
+	// four independent lanes take 32 bytes at a time; the rest of each row goes to a fifth
+	UINT64 lane0 = U64(0x60ea27eeadc0b5d6), lane1 = U64(0xc2b2ae3d27d4eb4f), lane2 = 0, lane3 = U64(0x61c8864e7a143579);
+	UINT64 rest = U64(0x27d4eb2f165667c5);
+	UINT32 rowbytes = sbounds.width() * bitmap.bpp() / 8;
+	for (INT32 y = sbounds.min_y; y <= sbounds.max_y; y++)
+	{
+		const UINT8 *src = reinterpret_cast<const UINT8 *>(bitmap.raw_pixptr(y, sbounds.min_x));
+		UINT32 remaining = rowbytes;
+		for ( ; remaining >= 32; remaining -= 32, src += 32)
+		{
+			lane0 = content_hash_round(lane0, content_hash_read(src + 0));
+			lane1 = content_hash_round(lane1, content_hash_read(src + 8));
+			lane2 = content_hash_round(lane2, content_hash_read(src + 16));
+			lane3 = content_hash_round(lane3, content_hash_read(src + 24));
+		}
+		for ( ; remaining >= 8; remaining -= 8, src += 8)
+			rest = content_hash_round(rest, content_hash_read(src));
+		for ( ; remaining > 0; remaining--)
+			rest = content_hash_round(rest, *src++);
+	}
+
+	// fold the lanes together and avalanche the result
+	UINT64 hash = ((lane0 << 1) | (lane0 >> 63)) + ((lane1 << 7) | (lane1 >> 57)) + ((lane2 << 12) | (lane2 >> 52)) + ((lane3 << 18) | (lane3 >> 46));
+	hash = content_hash_round(hash, rest);
+	hash ^= hash >> 33;
+	hash *= U64(0xc2b2ae3d27d4eb4f);
+	hash ^= hash >> 29;
+	return hash;
+}
+
+
 //-------------------------------------------------
 //  hq_scale - generic high quality resampling
 //  scaler
@@ -470,7 +538,10 @@ bool render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.width = swidth;
 		texinfo.height = sheight;
 		texinfo.palette = palbase;
-		texinfo.seqid = ++m_curseq;
+
+		// hashed content only changes through set_bitmap or the container's
+		// adjustments (see get_adjusted_palette); otherwise assume the worst
+		texinfo.seqid = m_hashed ? m_hashseq : ++m_curseq;
 		return true;
 	}
 
@@ -572,6 +643,14 @@ const rgb_t *render_texture::get_adjusted_palette(render_container &container)
 		case TEXFORMAT_ARGB32:
 		case TEXFORMAT_YUY16:
 
+			// the OSD applies this table while uploading, so a hashed texture
+			// needs a new seqid when it changes even though the pixels did not
+			if (m_hashed && m_hashbcg != container.bcg_sequence())
+			{
+				m_hashbcg = container.bcg_sequence();
+				m_hashseq = ++m_curseq;
+			}
+
 			// if no adjustment necessary, return NULL
 			if (!container.has_brightness_contrast_gamma_changes())
 				return NULL;
@@ -602,7 +681,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 		m_screen(screen),
 		m_overlaybitmap(NULL),
 		m_overlaytexture(NULL),
-		m_palclient(NULL)
+		m_palclient(NULL),
+		m_bcgseq(0)
 {
 	// all palette entries are opaque by default
 	for (int color = 0; color < ARRAY_LENGTH(m_bcglookup); color++)
@@ -830,6 +910,9 @@ render_container::item &render_container::add_generic(UINT8 type, float x0, floa
 
 void render_container::recompute_lookups()
 {
+	// let hashed textures know their adjusted colors changed
+	m_bcgseq++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -1762,10 +1845,12 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					int height = (finalorient & ORIENTATION_SWAP_XY) ? (prim->bounds.x1 - prim->bounds.x0) : (prim->bounds.y1 - prim->bounds.y0);
 					width = MIN(width, m_maxtexwidth);
 					height = MIN(height, m_maxtexheight);
+					// fetch the palette first, since a change in adjustments gives hashed textures a new seqid
+					const rgb_t *palette = curitem->texture()->get_adjusted_palette(container);
 					if (curitem->texture()->get_scaled(width, height, prim->texture, list))
 					{
 						// set the palette
-						prim->texture.palette = curitem->texture()->get_adjusted_palette(container);
+						prim->texture.palette = palette;
 
 						// determine UV coordinates and apply clipping
 						prim->texcoords = oriented_texcoords[finalorient];
@@ -2413,6 +2498,7 @@ render_manager::render_manager(running_machine &machine)
 		m_ui_target(NULL),
 		m_live_textures(0),
 		m_texture_allocator(machine.respool()),
+		m_texture_hash(machine.options().texture_hash()),
 		m_ui_container(auto_alloc(machine, render_container(*this))),
 		m_screen_container_list(machine.respool())
 {
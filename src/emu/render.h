@@ -438,6 +438,7 @@ private:
 	// internal helpers
 	bool get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist);
 	const rgb_t *get_adjusted_palette(render_container &container);
+	static UINT64 content_hash(bitmap_t &bitmap, const rectangle &sbounds);
 
 	static const int MAX_TEXTURE_SCALES = 8;
 
@@ -462,6 +463,12 @@ private:
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
+
+	// content hashing state (direct color formats only)
+	bool                m_hashed;                   // true if m_hash describes the current source
+	UINT64              m_hash;                     // hash of the source bounds at the last set_bitmap
+	UINT32              m_hashseq;                  // sequence number of the hashed content
+	UINT32              m_hashbcg;                  // container adjustment sequence m_hashseq reflects
 };
 
 
@@ -529,6 +536,7 @@ public:
 	UINT8 apply_brightness_contrast_gamma(UINT8 value);
 	float apply_brightness_contrast_gamma_fp(float value);
 	const rgb_t *bcg_lookup_table(int texformat, palette_t *palette = NULL);
+	UINT32 bcg_sequence() const { return m_bcgseq; }
 
 private:
 	// an item describes a high level primitive that is added to a container
@@ -581,6 +589,7 @@ private:
 	palette_client *        m_palclient;            // client to the system palette
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
 	rgb_t                   m_bcglookup[0x10000];   // full palette lookup with bcg adjustements
+	UINT32                  m_bcgseq;               // bumped each time the lookups are recomputed
 };
 
 
@@ -762,6 +771,9 @@ public:
 	// reference tracking
 	void invalidate_all(void *refptr);
 
+	// options
+	bool texture_hash() const { return m_texture_hash; }
+
 private:
 	// containers
 	render_container *container_alloc(screen_device *screen = NULL);
@@ -781,6 +793,7 @@ private:
 	// texture lists
 	UINT32                          m_live_textures;    // number of live textures
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
+	bool                            m_texture_hash;     // skip re-scaling/re-uploading unchanged textures
 
 	// containers for the UI and for screens
 	render_container *              m_ui_container;     // UI container
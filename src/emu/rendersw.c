@@ -28,6 +28,21 @@ private:
 		INT32           endx, endy;
 	};
 
+	// a horizontal stripe of the target, rasterized on a worker thread
+	struct stripe_data
+	{
+		const render_primitive_list *primlist;
+		_PixelType *    dstdata;
+		INT32           width, height;
+		INT32           miny, maxy;
+		UINT32          pitch;
+	};
+
+	// each stripe re-walks the whole primitive list, so stripes need to be tall
+	// enough for the drawing to outweigh that
+	static const INT32 MIN_STRIPE_PIXELS = 32768;
+	static const int MAX_STRIPES = 16;
+
 	// internal helpers
 	static inline bool is_opaque(float alpha) { return (alpha >= (_NoDestRead ? 0.5f : 1.0f)); }
 	static inline bool is_transparent(float alpha) { return (alpha < (_NoDestRead ? 0.5f : 0.0001f)); }
@@ -505,10 +520,11 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw a solid rectangle, clipped
+	//  to rows miny through maxy - 1
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 miny, INT32 maxy, UINT32 pitch)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -525,10 +541,10 @@ private:
 		if (startx >= width) startx = width;
 		if (endx < 0) endx = 0;
 		if (endx >= width) endx = width;
-		if (starty < 0) starty = 0;
-		if (starty >= height) starty = height;
-		if (endy < 0) endy = 0;
-		if (endy >= height) endy = height;
+		if (starty < miny) starty = miny;
+		if (starty >= maxy) starty = maxy;
+		if (endy < miny) endy = miny;
+		if (endy >= maxy) endy = maxy;
 
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
@@ -1808,10 +1824,11 @@ private:
 	//-------------------------------------------------
 	//  setup_and_draw_textured_quad - perform setup
 	//  and then dispatch to a texture-mode-specific
-	//  drawing routine
+	//  drawing routine; only rows miny through
+	//  maxy - 1 are drawn
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, INT32 miny, INT32 maxy, UINT32 pitch)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1858,6 +1875,16 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// clip to the requested rows, stepping U/V down to the first one
+		if (setup.starty < miny)
+		{
+			setup.startu += (miny - setup.starty) * setup.dudy;
+			setup.startv += (miny - setup.starty) * setup.dvdy;
+			setup.starty = miny;
+		}
+		if (setup.endy > maxy)
+			setup.endy = maxy;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1907,35 +1934,86 @@ private:
 	}
 
 
+	//-------------------------------------------------
+	//  draw_stripe_callback - draw the quads of a
+	//  primitive list that fall within one stripe
+	//-------------------------------------------------
+
+	static void *draw_stripe_callback(void *param, int threadid)
+	{
+		stripe_data &stripe = *reinterpret_cast<stripe_data *>(param);
+		for (const render_primitive *prim = stripe.primlist->first(); prim != NULL; prim = prim->next())
+		{
+			assert(prim->type == render_primitive::QUAD);
+			if (!prim->texture.base)
+				draw_rect(*prim, stripe.dstdata, stripe.width, stripe.miny, stripe.maxy, stripe.pitch);
+			else
+				setup_and_draw_textured_quad(*prim, stripe.dstdata, stripe.width, stripe.height, stripe.miny, stripe.maxy, stripe.pitch);
+		}
+		return NULL;
+	}
+
+
 	//**************************************************************************
 	//  PRIMARY ENTRY POINT
 	//**************************************************************************
 
 	//-------------------------------------------------
 	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  using a software rasterizer; given a work
+	//  queue, large targets are split into stripes
+	//  that are drawn in parallel
 	//-------------------------------------------------
 
 public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue = NULL)
 	{
+		// work out how many stripes are worth it; lines aren't clipped to
+		// stripes, so any list containing them is drawn in one go
+		int stripes = MIN(INT32(width * height) / MIN_STRIPE_PIXELS, INT32(height));
+		stripes = MIN(stripes, MAX_STRIPES);
+		for (const render_primitive *prim = primlist.first(); prim != NULL && stripes > 1; prim = prim->next())
+			if (prim->type == render_primitive::LINE)
+				stripes = 1;
+
 		// loop over the list and render each element
-		for (const render_primitive *prim = primlist.first(); prim != NULL; prim = prim->next())
-			switch (prim->type)
-			{
-				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					break;
-
-				case render_primitive::QUAD:
-					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
-					break;
-
-				default:
-					throw emu_fatalerror("Unexpected render_primitive type");
-			}
+		if (queue == NULL || stripes <= 1)
+		{
+			for (const render_primitive *prim = primlist.first(); prim != NULL; prim = prim->next())
+				switch (prim->type)
+				{
+					case render_primitive::LINE:
+						draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						break;
+
+					case render_primitive::QUAD:
+						if (!prim->texture.base)
+							draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, 0, height, pitch);
+						else
+							setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, 0, height, pitch);
+						break;
+
+					default:
+						throw emu_fatalerror("Unexpected render_primitive type");
+				}
+			return;
+		}
+
+		// split the target into horizontal stripes; each one walks the whole list
+		// in order, so overlapping primitives still blend in the same order
+		stripe_data stripe[MAX_STRIPES];
+		for (int stripenum = 0; stripenum < stripes; stripenum++)
+		{
+			stripe[stripenum].primlist = &primlist;
+			stripe[stripenum].dstdata = reinterpret_cast<_PixelType *>(dstdata);
+			stripe[stripenum].width = width;
+			stripe[stripenum].height = height;
+			stripe[stripenum].miny = height * stripenum / stripes;
+			stripe[stripenum].maxy = height * (stripenum + 1) / stripes;
+			stripe[stripenum].pitch = pitch;
+		}
+
+		// the OSD presents the target as soon as we return
+		osd_work_item_run_multiple(queue, draw_stripe_callback, stripes, stripe, sizeof(stripe[0]));
 	}
 };
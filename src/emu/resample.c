@@ -0,0 +1,269 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    resample.c
+
+    Sample rate conversion kernels for sound streams.
+
+***************************************************************************/
+
+#include "emucore.h"
+#include "emutempl.h"
+#include "resample.h"
+
+// use SSE2 on 64-bit implementations, where it can be assumed
+#if (defined(__SSE2__) && defined(PTR64))
+#define RESAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// fraction of the lower Nyquist frequency passed by the polyphase filters
+const double RESAMPLE_CUTOFF = 0.9;
+
+// Kaiser window shape for the polyphase filters (about 80dB of stopband)
+const double RESAMPLE_KAISER_BETA = 8.0;
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  bessel_i0 - zeroth-order modified Bessel
+//  function of the first kind, for the Kaiser
+//  window
+//-------------------------------------------------
+
+static double bessel_i0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 50 && term > sum * 1e-12; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+
+//-------------------------------------------------
+//  resample_convolve - apply one phase of a
+//  polyphase filter to the source samples; taps
+//  is a multiple of 4
+//-------------------------------------------------
+
+inline float resample_convolve(const stream_sample_t *source, const float *coeffs, int taps)
+{
+#ifdef RESAMPLE_SSE2
+	__m128 sum = _mm_setzero_ps();
+	for (int tap = 0; tap < taps; tap += 4)
+	{
+		__m128 samples = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[tap])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(samples, _mm_loadu_ps(&coeffs[tap])));
+	}
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+#else
+	float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+	for (int tap = 0; tap < taps; tap += 4)
+	{
+		sum0 += float(source[tap + 0]) * coeffs[tap + 0];
+		sum1 += float(source[tap + 1]) * coeffs[tap + 1];
+		sum2 += float(source[tap + 2]) * coeffs[tap + 2];
+		sum3 += float(source[tap + 3]) * coeffs[tap + 3];
+	}
+	return (sum0 + sum1) + (sum2 + sum3);
+#endif
+}
+
+
+
+//**************************************************************************
+//  RESAMPLE FILTER
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_filter - constructor
+//-------------------------------------------------
+
+resample_filter::resample_filter(UINT32 inrate, UINT32 outrate)
+	: m_next(NULL),
+		m_inrate(inrate),
+		m_outrate(outrate),
+		m_taps(2 * MIN(compute_half_taps(inrate, outrate), MAX_HALF_TAPS)),
+		m_coeffs(PHASES * m_taps)
+{
+	// the cutoff is relative to the source's Nyquist frequency, so when
+	// downsampling the filter spans proportionally more source samples
+	double cutoff = MIN(1.0, double(outrate) / double(inrate)) * RESAMPLE_CUTOFF;
+	int half = m_taps / 2;
+	double window_scale = 1.0 / bessel_i0(RESAMPLE_KAISER_BETA);
+
+	// tap N applies to the source sample N - (half - 1) from the current one;
+	// each phase is built for the middle of the fractions that select it
+	for (int phase = 0; phase < PHASES; phase++)
+	{
+		float *coeffs = &m_coeffs[phase * m_taps];
+		double frac = (phase + 0.5) / PHASES;
+		double sum = 0;
+		for (int tap = 0; tap < m_taps; tap++)
+		{
+			double x = double(tap - (half - 1)) - frac;
+			double t = x / half;
+			double window = bessel_i0(RESAMPLE_KAISER_BETA * sqrt(MAX(0.0, 1.0 - t * t))) * window_scale;
+			double sinc = (x == 0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			double value = cutoff * sinc * window;
+			coeffs[tap] = value;
+			sum += value;
+		}
+
+		// normalize each phase to unity gain so that DC passes unchanged
+		for (int tap = 0; tap < m_taps; tap++)
+			coeffs[tap] /= sum;
+	}
+}
+
+
+//-------------------------------------------------
+//  resample - convolve the source with the phase
+//  nearest each output position
+//-------------------------------------------------
+
+void resample_filter::resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples) const
+{
+	float scale = float(gain) / 256.0f;
+	source -= half_taps() - 1;
+	while (numsamples--)
+	{
+		float sample = resample_convolve(source, coefficients(basefrac >> (RESAMPLE_FRAC_BITS - PHASE_BITS)), m_taps) * scale;
+		*dest++ = stream_sample_t((sample < 0) ? (sample - 0.5f) : (sample + 0.5f));
+
+		// advance
+		basefrac += step;
+		source += basefrac >> RESAMPLE_FRAC_BITS;
+		basefrac &= RESAMPLE_FRAC_MASK;
+	}
+}
+
+
+//-------------------------------------------------
+//  compute_half_taps - return the number of taps
+//  needed on each side of the center, rounded
+//  up to an even number
+//-------------------------------------------------
+
+int resample_filter::compute_half_taps(UINT32 inrate, UINT32 outrate)
+{
+	double cutoff = MIN(1.0, double(outrate) / double(inrate)) * RESAMPLE_CUTOFF;
+	int half = int(ceil(ZERO_CROSSINGS / cutoff));
+	return (half + 1) & ~1;
+}
+
+
+//-------------------------------------------------
+//  usable - return true if a filter is worth
+//  building for the given rates; very large
+//  downsampling ratios are left to the fast
+//  resampler, which already averages the source
+//-------------------------------------------------
+
+bool resample_filter::usable(UINT32 inrate, UINT32 outrate)
+{
+	return (inrate != outrate && compute_half_taps(inrate, outrate) <= MAX_HALF_TAPS);
+}
+
+
+
+//**************************************************************************
+//  FAST RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_fast - copy, point sample or average
+//  the source depending on the stepping fraction
+//-------------------------------------------------
+
+void resample_fast(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
+	// if we have equal sample rates, we just need to copy
+	if (step == RESAMPLE_FRAC_ONE)
+	{
+		while (numsamples--)
+		{
+			// compute the sample
+			stream_sample_t sample = *source++;
+			*dest++ = (sample * gain) >> 8;
+		}
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	else if (step < RESAMPLE_FRAC_ONE)
+	{
+		while (numsamples != 0)
+		{
+			// fill in with point samples until we hit a boundary
+			int nextfrac;
+			while ((nextfrac = basefrac + step) < RESAMPLE_FRAC_ONE && numsamples--)
+			{
+				*dest++ = (source[0] * gain) >> 8;
+				basefrac = nextfrac;
+			}
+
+			// if we're done, we're done
+			if (INT32(numsamples--) < 0)
+				break;
+
+			// compute starting and ending fractional positions
+			int startfrac = basefrac >> (RESAMPLE_FRAC_BITS - 12);
+			int endfrac = nextfrac >> (RESAMPLE_FRAC_BITS - 12);
+
+			// blend between the two samples accordingly
+			stream_sample_t sample = (source[0] * (0x1000 - startfrac) + source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac = nextfrac & RESAMPLE_FRAC_MASK;
+			source++;
+		}
+	}
+
+	// input is oversampled: sum the energy
+	else
+	{
+		// use 8 bits to allow some extra headroom
+		int smallstep = step >> (RESAMPLE_FRAC_BITS - 8);
+		while (numsamples--)
+		{
+			int remainder = smallstep;
+			int tpos = 0;
+
+			// compute the sample
+			int scale = (RESAMPLE_FRAC_ONE - basefrac) >> (RESAMPLE_FRAC_BITS - 8);
+			stream_sample_t sample = source[tpos++] * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += source[tpos++] * 0x100;
+				remainder -= 0x100;
+			}
+			sample += source[tpos] * remainder;
+			sample /= smallstep;
+
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> RESAMPLE_FRAC_BITS;
+			basefrac &= RESAMPLE_FRAC_MASK;
+		}
+	}
+}
@@ -0,0 +1,86 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    resample.h
+
+    Sample rate conversion kernels for sound streams.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RESAMPLE_H__
+#define __RESAMPLE_H__
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// positions between source samples are fixed-point fractions of RESAMPLE_FRAC_ONE
+const UINT32 RESAMPLE_FRAC_BITS = 22;
+const UINT32 RESAMPLE_FRAC_ONE = 1 << RESAMPLE_FRAC_BITS;
+const UINT32 RESAMPLE_FRAC_MASK = RESAMPLE_FRAC_ONE - 1;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> resample_filter
+
+// a polyphase windowed-sinc filter converting between a pair of sample rates;
+// it is shared by every stream input that converts between the same rates
+class resample_filter
+{
+	friend class simple_list<resample_filter>;
+
+public:
+	// constants
+	static const int PHASE_BITS             = 9;
+	static const int PHASES                 = 1 << PHASE_BITS;
+	static const int ZERO_CROSSINGS         = 8;        // zero crossings of the sinc on each side
+	static const int MAX_HALF_TAPS          = 96;       // limit on taps on each side of the center
+
+	// construction/destruction
+	resample_filter(UINT32 inrate, UINT32 outrate);
+
+	// getters
+	resample_filter *next() const { return m_next; }
+	UINT32 input_rate() const { return m_inrate; }
+	UINT32 output_rate() const { return m_outrate; }
+	int taps() const { return m_taps; }
+	int half_taps() const { return m_taps / 2; }
+	const float *coefficients(UINT32 phase) const { return &m_coeffs[phase * m_taps]; }
+
+	// conversion; reads half_taps() - 1 samples behind the source pointer
+	void resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples) const;
+
+	// helpers
+	static bool usable(UINT32 inrate, UINT32 outrate);
+
+private:
+	static int compute_half_taps(UINT32 inrate, UINT32 outrate);
+
+	// internal state
+	resample_filter *   m_next;                 // next filter in the list
+	UINT32              m_inrate;               // sample rate of the source
+	UINT32              m_outrate;              // sample rate produced
+	int                 m_taps;                 // taps per phase, always a multiple of 4
+	dynamic_array<float> m_coeffs;              // PHASES rows of m_taps coefficients
+};
+
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+// point sample/average conversion, used where there is no filter
+void resample_fast(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples);
+
+
+#endif  /* __RESAMPLE_H__ */
@@ -11,7 +11,7 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 2, or 3 for delta states)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
@@ -20,6 +20,21 @@
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+    Delta states (format 3, SS_DELTA set) replace the save game data with:
+
+    00..03  CRC32 of the full state the delta was made against
+    04..07  Size of the delta in bytes
+    08..0B  Length of the reference file name
+    0C..    Reference file name, as passed to emu_file::open
+    ...end  Delta records, as made by delta_encode
+
+    The reference is an ordinary full state file; its save game data
+    laid end to end is exactly what write_buffer produces. Each delta
+    record is a 32-bit block index followed by that block XORed with
+    the same DELTA_BLOCK_SIZE block of the reference; unchanged blocks
+    have no record. Delta states cannot be converted from the other
+    endianness, and neither can the reference they need.
+
 ***************************************************************************/
 
 #include "emu.h"
@@ -42,12 +57,17 @@
 //**************************************************************************
 
 const int SAVE_VERSION      = 2;
+const int SAVE_DELTA_VERSION = 3;
 const int HEADER_SIZE       = 32;
+const int DELTA_INFO_SIZE   = 12;
+const int DELTA_BLOCK_SIZE  = 4096;
+const int DELTA_MAX_NAME    = 1024;
 
 // Available flags
 enum
 {
-	SS_MSB_FIRST = 0x02
+	SS_MSB_FIRST = 0x02,
+	SS_DELTA     = 0x04
 };
 
 
@@ -63,6 +83,8 @@ save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
 		m_illegal_regs(0),
+		m_state_size(0),
+		m_reference_crc(0),
 		m_entry_list(machine.respool()),
 		m_presave_list(machine.respool()),
 		m_postload_list(machine.respool())
@@ -80,7 +102,17 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
 		dump_registry();
+
+		// lay out the entries back to back for in-memory snapshots
+		m_state_size = 0;
+		for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		{
+			entry->m_offset = m_state_size;
+			m_state_size += entry->m_typesize * entry->m_typecount;
+		}
+	}
 }
 
 
@@ -218,10 +250,13 @@ save_error save_manager::check_file(running_machine &machine, emu_file &file, co
 
 
 //-------------------------------------------------
-//  read_file - read the data from a file
+//  read_file - read the data from a file; full
+//  states are kept as the reference for delta
+//  files if refname is given, and delta states
+//  look for their reference along searchpath
 //-------------------------------------------------
 
-save_error save_manager::read_file(emu_file &file)
+save_error save_manager::read_file(emu_file &file, const char *refname, const char *searchpath)
 {
 	// if we have illegal registrations, return an error
 	if (m_illegal_regs > 0)
@@ -243,6 +278,17 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// delta states are rebuilt from their reference before anything is touched
+	if (header[9] & SS_DELTA)
+	{
+		if (flip)
+		{
+			popmessage("Error: Delta save states can't be loaded on a machine of the other endianness");
+			return STATERR_INVALID_HEADER;
+		}
+		return read_delta_data(file, refname, searchpath);
+	}
+
 	// read all the data, flipping if necessary
 	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
 	{
@@ -255,6 +301,10 @@ save_error save_manager::read_file(emu_file &file)
 			entry->flip_data();
 	}
 
+	// keep the data as it was in the file, before any post-load fixups
+	if (refname != NULL && !flip)
+		keep_reference(refname);
+
 	// call the post-load functions
 	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
 		func->m_func();
@@ -264,20 +314,223 @@ save_error save_manager::read_file(emu_file &file)
 
 
 //-------------------------------------------------
-//  write_file - writes the data to a file
+//  write_file - writes the data to a file; if
+//  refname is given, the state written becomes
+//  the reference for delta files
+//-------------------------------------------------
+
+save_error save_manager::write_file(emu_file &file, const char *refname)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// the old reference may be the file we are about to overwrite
+	if (refname != NULL)
+		m_reference.reset();
+
+	// write the header and turn on compression for the rest of the file
+	if (!write_header(file, SAVE_VERSION, 0))
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// then write all the data
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (file.write(entry->m_data, totalsize) != totalsize)
+			return STATERR_WRITE_ERROR;
+	}
+
+	// keep what we wrote
+	if (refname != NULL)
+		keep_reference(refname);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_delta_file - writes the data to a file
+//  as a delta against the reference state
+//-------------------------------------------------
+
+save_error save_manager::write_delta_file(emu_file &file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (!has_reference())
+		return STATERR_REFERENCE_ERROR;
+
+	// snapshot the state (this calls the pre-save functions) and diff it
+	dynamic_buffer state(m_state_size);
+	save_error err = write_buffer(state, m_state_size);
+	if (err != STATERR_NONE)
+		return err;
+	dynamic_buffer delta(delta_max_size(m_state_size));
+	UINT32 deltasize = delta_encode(state, m_reference, m_state_size, delta);
+
+	// write the header and turn on compression for the rest of the file
+	if (!write_header(file, SAVE_DELTA_VERSION, SS_DELTA))
+		return STATERR_WRITE_ERROR;
+
+	// then the reference we were made against and the delta records
+	UINT8 info[DELTA_INFO_SIZE];
+	UINT32 namelength = m_reference_name.len();
+	*(UINT32 *)&info[0] = LITTLE_ENDIANIZE_INT32(m_reference_crc);
+	*(UINT32 *)&info[4] = LITTLE_ENDIANIZE_INT32(deltasize);
+	*(UINT32 *)&info[8] = LITTLE_ENDIANIZE_INT32(namelength);
+	if (file.write(info, sizeof(info)) != sizeof(info))
+		return STATERR_WRITE_ERROR;
+	if (file.write(m_reference_name.cstr(), namelength) != namelength)
+		return STATERR_WRITE_ERROR;
+	if (file.write(delta, deltasize) != deltasize)
+		return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_buffer - snapshot all registered data
+//  into a caller-supplied buffer of
+//  state_size() bytes
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(void *buf, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_state_size)
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// then copy all the data
+	UINT8 *dest = reinterpret_cast<UINT8 *>(buf);
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		memcpy(dest + entry->m_offset, entry->m_data, entry->m_typesize * entry->m_typecount);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - restore all registered data
+//  from a buffer filled by write_buffer
 //-------------------------------------------------
 
-save_error save_manager::write_file(emu_file &file)
+save_error save_manager::read_buffer(const void *buf, UINT32 size)
 {
 	// if we have illegal registrations, return an error
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_state_size)
+		return STATERR_READ_ERROR;
+
+	// copy all the data; it was written by us, so never needs flipping
+	const UINT8 *src = reinterpret_cast<const UINT8 *>(buf);
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		memcpy(entry->m_data, src + entry->m_offset, entry->m_typesize * entry->m_typecount);
+
+	// call the post-load functions
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  delta_max_size - return the largest possible
+//  delta between two snapshots of the given size
+//-------------------------------------------------
+
+UINT32 save_manager::delta_max_size(UINT32 size)
+{
+	UINT32 blocks = (size + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+	return size + blocks * sizeof(UINT32);
+}
+
+
+//-------------------------------------------------
+//  delta_encode - XOR each block of a snapshot
+//  that differs from the reference into dest,
+//  which must hold delta_max_size() bytes;
+//  returns the number of bytes used
+//-------------------------------------------------
+
+UINT32 save_manager::delta_encode(const UINT8 *state, const UINT8 *reference, UINT32 size, UINT8 *dest)
+{
+	UINT8 *out = dest;
+	for (UINT32 offset = 0; offset < size; offset += DELTA_BLOCK_SIZE)
+	{
+		// skip blocks that have not changed
+		UINT32 length = MIN(size - offset, DELTA_BLOCK_SIZE);
+		if (memcmp(state + offset, reference + offset, length) == 0)
+			continue;
+
+		// emit the block index followed by the XORed block
+		UINT32 block = offset / DELTA_BLOCK_SIZE;
+		memcpy(out, &block, sizeof(block));
+		out += sizeof(block);
+		for (UINT32 index = 0; index < length; index++)
+			out[index] = state[offset + index] ^ reference[offset + index];
+		out += length;
+	}
+	return out - dest;
+}
+
 
+//-------------------------------------------------
+//  delta_apply - XOR a delta made by delta_encode
+//  onto a snapshot; since XOR is symmetric this
+//  turns either side of the delta into the other
+//-------------------------------------------------
+
+bool save_manager::delta_apply(UINT8 *state, UINT32 size, const UINT8 *delta, UINT32 deltasize)
+{
+	const UINT8 *end = delta + deltasize;
+	while (delta < end)
+	{
+		// fetch and validate the block index
+		UINT32 block;
+		if (end - delta < sizeof(block))
+			return false;
+		memcpy(&block, delta, sizeof(block));
+		delta += sizeof(block);
+		if (block >= (size + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE)
+			return false;
+
+		// XOR the block back in
+		UINT32 offset = block * DELTA_BLOCK_SIZE;
+		UINT32 length = MIN(size - offset, DELTA_BLOCK_SIZE);
+		if (end - delta < length)
+			return false;
+		for (UINT32 index = 0; index < length; index++)
+			state[offset + index] ^= delta[index];
+		delta += length;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  write_header - write the file header and turn
+//  on compression for the rest of the file
+//-------------------------------------------------
+
+bool save_manager::write_header(emu_file &file, UINT8 version, UINT8 flags)
+{
 	// generate the header
 	UINT8 header[HEADER_SIZE];
 	memcpy(&header[0], emulator_info::get_state_magic_num(), 8);
-	header[8] = SAVE_VERSION;
-	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
+	header[8] = version;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST) | flags;
 	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
@@ -286,24 +539,113 @@ save_error save_manager::write_file(emu_file &file)
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	if (file.write(header, sizeof(header)) != sizeof(header))
-		return STATERR_WRITE_ERROR;
+		return false;
 	file.compress(FCOMPRESS_MEDIUM);
+	return true;
+}
 
-	// call the pre-save functions
-	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
-		func->m_func();
 
-	// then write all the data
-	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+//-------------------------------------------------
+//  read_delta_data - read the body of a delta
+//  state, rebuild the full state from its
+//  reference and load it
+//-------------------------------------------------
+
+save_error save_manager::read_delta_data(emu_file &file, const char *refname, const char *searchpath)
+{
+	// read the reference information and the delta records
+	UINT8 info[DELTA_INFO_SIZE];
+	if (file.read(info, sizeof(info)) != sizeof(info))
+		return STATERR_READ_ERROR;
+	UINT32 crc = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&info[0]);
+	UINT32 deltasize = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&info[4]);
+	UINT32 namelength = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&info[8]);
+	if (deltasize > delta_max_size(m_state_size) || namelength == 0 || namelength > DELTA_MAX_NAME)
+		return STATERR_READ_ERROR;
+
+	dynamic_buffer name(namelength);
+	if (file.read(name, namelength) != namelength)
+		return STATERR_READ_ERROR;
+	astring basename((const char *)&name[0], namelength);
+	dynamic_buffer delta(deltasize);
+	if (file.read(delta, deltasize) != deltasize)
+		return STATERR_READ_ERROR;
+
+	// start from the reference we hold, or else from the file it names
+	dynamic_buffer state(m_state_size);
+	bool held = (has_reference() && m_reference_crc == crc);
+	if (held)
+		memcpy(state, m_reference, m_state_size);
+	else
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
-			return STATERR_WRITE_ERROR;
+		save_error err = read_reference_file(basename, searchpath, state);
+		if (err != STATERR_NONE)
+			return err;
+		if (crc32(0, state, m_state_size) != crc)
+			return STATERR_REFERENCE_ERROR;
 	}
+
+	// a freshly read reference is as good as one we wrote ourselves
+	if (!held && refname != NULL)
+	{
+		m_reference.resize(m_state_size);
+		memcpy(m_reference, state, m_state_size);
+		m_reference_crc = crc;
+		m_reference_name.cpy(basename);
+	}
+
+	// only touch the machine once the whole delta has applied cleanly
+	if (!delta_apply(state, m_state_size, delta, deltasize))
+		return STATERR_READ_ERROR;
+	return read_buffer(state, m_state_size);
+}
+
+
+//-------------------------------------------------
+//  read_reference_file - read the data of the
+//  full state a delta was made against into a
+//  buffer of state_size() bytes
+//-------------------------------------------------
+
+save_error save_manager::read_reference_file(const char *name, const char *searchpath, UINT8 *dest)
+{
+	// open the file and read the header
+	emu_file file(searchpath, OPEN_FLAG_READ);
+	if (file.open(name) != FILERR_NONE)
+		return STATERR_REFERENCE_ERROR;
+	UINT8 header[HEADER_SIZE];
+	if (file.read(header, sizeof(header)) != sizeof(header))
+		return STATERR_READ_ERROR;
+	file.compress(FCOMPRESS_MEDIUM);
+
+	// it must be a full state for this game, written with our endianness
+	if (validate_header(header, machine().system().name, signature(), NULL, "") != STATERR_NONE)
+		return STATERR_REFERENCE_ERROR;
+	if ((header[9] & SS_DELTA) != 0 || (header[9] & SS_MSB_FIRST) != NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST))
+		return STATERR_REFERENCE_ERROR;
+
+	// the entries are laid out back to back, just as write_buffer does
+	if (file.read(dest, m_state_size) != m_state_size)
+		return STATERR_READ_ERROR;
 	return STATERR_NONE;
 }
 
 
+//-------------------------------------------------
+//  keep_reference - copy the registered data as
+//  the reference for delta files
+//-------------------------------------------------
+
+void save_manager::keep_reference(const char *refname)
+{
+	m_reference.resize(m_state_size);
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		memcpy(&m_reference[entry->m_offset], entry->m_data, entry->m_typesize * entry->m_typecount);
+	m_reference_crc = crc32(0, m_reference, m_state_size);
+	m_reference_name.cpy(refname);
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -356,11 +698,12 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 		return STATERR_INVALID_HEADER;
 	}
 
-	// check save state version
-	if (header[8] != SAVE_VERSION)
+	// check save state version; delta states have their own
+	int version = (header[9] & SS_DELTA) ? SAVE_DELTA_VERSION : SAVE_VERSION;
+	if (header[8] != version)
 	{
 		if (errormsg != NULL)
-			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
+			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], version);
 		return STATERR_INVALID_HEADER;
 	}
 
@@ -446,3 +789,109 @@ void save_manager::state_entry::flip_data()
 			break;
 	}
 }
+
+
+
+//**************************************************************************
+//  REWIND RING
+//**************************************************************************
+
+//-------------------------------------------------
+//  rewind_ring - constructor
+//-------------------------------------------------
+
+rewind_ring::rewind_ring(save_manager &save, int capacity)
+	: m_save(save),
+		m_capacity(capacity),
+		m_slotsize(save.state_size()),
+		m_newest(0),
+		m_encode(save_manager::delta_max_size(save.state_size())),
+		m_delta(capacity),
+		m_head(0),
+		m_count(0)
+{
+	assert_always(!save.registration_allowed(), "rewind_ring created before save state registration closed");
+	m_state[0].resize(m_slotsize);
+	m_state[1].resize(m_slotsize);
+}
+
+
+//-------------------------------------------------
+//  memory_used - return the number of bytes held
+//  by valid snapshots
+//-------------------------------------------------
+
+size_t rewind_ring::memory_used() const
+{
+	size_t total = (m_count > 0) ? m_slotsize : 0;
+	for (int index = 1; index < m_count; index++)
+		total += m_delta[(m_head + m_capacity - index) % m_capacity].count();
+	return total;
+}
+
+
+//-------------------------------------------------
+//  capture - snapshot the current state; the
+//  previous newest state is kept as a delta
+//  against it, overwriting the oldest when full
+//-------------------------------------------------
+
+save_error rewind_ring::capture()
+{
+	int next = m_newest ^ 1;
+	save_error err = m_save.write_buffer(m_state[next], m_slotsize);
+	if (err != STATERR_NONE)
+		return err;
+
+	// turn the previous newest state into a delta against the new one
+	if (m_count > 0)
+	{
+		UINT32 size = save_manager::delta_encode(m_state[m_newest], m_state[next], m_slotsize, m_encode);
+		dynamic_array<UINT8> &delta = m_delta[m_head];
+		delta.reset();
+		delta.resize(size);
+		memcpy(delta, m_encode, size);
+		m_head = (m_head + 1) % m_capacity;
+	}
+	m_newest = next;
+	if (m_count < m_capacity)
+		m_count++;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  step_back - restore the most recent snapshot
+//  and drop it, so repeated calls walk further
+//  back in time
+//-------------------------------------------------
+
+save_error rewind_ring::step_back()
+{
+	if (m_count == 0)
+		return STATERR_READ_ERROR;
+
+	// rebuild the next older state from its delta in the spare slot first,
+	// so that a bad delta fails the step before anything is restored
+	int older = m_newest ^ 1;
+	int head = (m_head + m_capacity - 1) % m_capacity;
+	if (m_count > 1)
+	{
+		dynamic_array<UINT8> &delta = m_delta[head];
+		memcpy(m_state[older], m_state[m_newest], m_slotsize);
+		if (!save_manager::delta_apply(m_state[older], m_slotsize, delta, delta.count()))
+			return STATERR_READ_ERROR;
+	}
+
+	save_error err = m_save.read_buffer(m_state[m_newest], m_slotsize);
+	if (err != STATERR_NONE)
+		return err;
+
+	// the older state is now the newest
+	if (--m_count > 0)
+	{
+		m_head = head;
+		m_newest = older;
+	}
+	return STATERR_NONE;
+}
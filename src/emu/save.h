@@ -29,7 +29,8 @@ enum save_error
 	STATERR_ILLEGAL_REGISTRATIONS,
 	STATERR_INVALID_HEADER,
 	STATERR_READ_ERROR,
-	STATERR_WRITE_ERROR
+	STATERR_WRITE_ERROR,
+	STATERR_REFERENCE_ERROR
 };
 
 
@@ -90,6 +91,7 @@ public:
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.count(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	UINT32 state_size() const { return m_state_size; }
 
 	// registration control
 	void allow_registration(bool allowed = true);
@@ -143,11 +145,30 @@ public:
 
 	// file processing
 	static save_error check_file(running_machine &machine, emu_file &file, const char *gamename, void (CLIB_DECL *errormsg)(const char *fmt, ...));
-	save_error write_file(emu_file &file);
-	save_error read_file(emu_file &file);
+	save_error write_file(emu_file &file, const char *refname = NULL);
+	save_error write_delta_file(emu_file &file);
+	save_error read_file(emu_file &file, const char *refname = NULL, const char *searchpath = NULL);
+
+	// the full state delta files are written against: the last one written
+	// or read with a reference name
+	bool has_reference() const { return (m_reference.count() != 0); }
+	const char *reference_name() const { return m_reference_name; }
+
+	// in-memory snapshots (native endianness, no header, state_size() bytes)
+	save_error write_buffer(void *buf, UINT32 size);
+	save_error read_buffer(const void *buf, UINT32 size);
+
+	// block-wise XOR deltas between two snapshots of the same size
+	static UINT32 delta_max_size(UINT32 size);
+	static UINT32 delta_encode(const UINT8 *state, const UINT8 *reference, UINT32 size, UINT8 *dest);
+	static bool delta_apply(UINT8 *state, UINT32 size, const UINT8 *delta, UINT32 deltasize);
 
 private:
 	// internal helpers
+	bool write_header(emu_file &file, UINT8 version, UINT8 flags);
+	save_error read_delta_data(emu_file &file, const char *refname, const char *searchpath);
+	save_error read_reference_file(const char *name, const char *searchpath, UINT8 *dest);
+	void keep_reference(const char *refname);
 	UINT32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
@@ -192,6 +213,10 @@ private:
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
 	int                     m_illegal_regs;         // number of illegal registrations
+	UINT32                  m_state_size;           // total size of all registered data
+	dynamic_buffer          m_reference;            // full state that delta files are made against
+	astring                 m_reference_name;       // file the reference was written to or read from
+	UINT32                  m_reference_crc;        // CRC32 of the reference
 
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
@@ -199,6 +224,40 @@ private:
 };
 
 
+// ======================> rewind_ring
+
+// a bounded ring of in-memory snapshots, oldest overwritten first; only the
+// newest state is kept whole, older ones are XOR deltas against their successor
+class rewind_ring
+{
+public:
+	// construction/destruction
+	rewind_ring(save_manager &save, int capacity);
+
+	// getters
+	int capacity() const { return m_capacity; }
+	int count() const { return m_count; }
+	size_t memory_used() const;
+
+	// operations
+	save_error capture();
+	save_error step_back();
+	void reset() { m_head = m_count = 0; }
+
+private:
+	// internal state
+	save_manager &          m_save;                 // reference to the save manager
+	int                     m_capacity;             // maximum number of snapshots
+	UINT32                  m_slotsize;             // size of one snapshot
+	dynamic_array<UINT8>    m_state[2];             // newest state and capture scratch
+	int                     m_newest;               // which of m_state holds the newest
+	dynamic_array<UINT8>    m_encode;               // worst-case delta encode buffer
+	dynamic_array<dynamic_array<UINT8> > m_delta;   // ring of deltas, one per older state
+	int                     m_head;                 // delta slot the next capture goes to
+	int                     m_count;                // number of valid snapshots
+};
+
+
 // template specializations to enumerate the fundamental atomic types you are allowed to save
 ALLOW_SAVE_TYPE_AND_ARRAY(char);
 ALLOW_SAVE_TYPE_AND_ARRAY(bool);
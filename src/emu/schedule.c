@@ -48,6 +48,8 @@ emu_timer::emu_timer()
 	: m_machine(NULL),
 		m_next(NULL),
 		m_prev(NULL),
+		m_heap_index(-1),
+		m_sequence(0),
 		m_param(0),
 		m_ptr(NULL),
 		m_enabled(false),
@@ -55,8 +57,11 @@ emu_timer::emu_timer()
 		m_period(attotime::zero),
 		m_start(attotime::zero),
 		m_expire(attotime::never),
+		m_batch(1),
+		m_periods(1),
 		m_device(NULL),
-		m_id(0)
+		m_id(0),
+		m_stats(NULL)
 {
 }
 
@@ -81,6 +86,8 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = NULL;
 	m_prev = NULL;
+	m_heap_index = -1;
+	m_sequence = 0;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -89,8 +96,11 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_period = attotime::never;
 	m_start = machine.time();
 	m_expire = attotime::never;
+	m_batch = 1;
+	m_periods = 1;
 	m_device = NULL;
 	m_id = 0;
+	m_stats = &machine.scheduler().machine_stats();
 
 	// if we're not temporary, register ourselves with the save state system
 	if (!m_temporary)
@@ -113,6 +123,8 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = NULL;
 	m_prev = NULL;
+	m_heap_index = -1;
+	m_sequence = 0;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -121,8 +133,13 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_period = attotime::never;
 	m_start = machine().time();
 	m_expire = attotime::never;
+	m_batch = 1;
+	m_periods = 1;
 	m_device = &device;
 	m_id = id;
+	m_stats = machine().scheduler().stats(device);
+	if (m_stats == NULL)
+		m_stats = &machine().scheduler().machine_stats();
 
 	// if we're not temporary, register ourselves with the save state system
 	if (!m_temporary)
@@ -160,9 +177,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// add to or remove from the expiration queue
+		machine().scheduler().timer_queue_update(*this);
 	}
 	return old;
 }
@@ -176,6 +192,10 @@ bool emu_timer::enable(bool enable)
 
 void emu_timer::adjust(attotime start_delay, INT32 param, attotime period)
 {
+	// a batched timer first delivers the periods that have already elapsed;
+	// the partial period in progress is dropped, as for any periodic timer
+	catch_up();
+
 	// if this is the callback timer, mark it modified
 	device_scheduler &scheduler = machine().scheduler();
 	if (scheduler.m_callback_timer == this)
@@ -193,13 +213,13 @@ void emu_timer::adjust(attotime start_delay, INT32 param, attotime period)
 	m_start = scheduler.time();
 	m_expire = m_start + start_delay;
 	m_period = period;
+	m_periods = 1;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the queue
+	scheduler.timer_queue_update(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	if (this == &scheduler.next_timer())
 		scheduler.abort_timeslice();
 }
 
@@ -211,6 +231,9 @@ void emu_timer::adjust(attotime start_delay, INT32 param, attotime period)
 
 attotime emu_timer::elapsed() const
 {
+	// partway through a batch, report the time into the current period
+	if (m_periods > 1)
+		return attotime(0, (machine().time() - m_start).as_attoseconds() % m_period.attoseconds);
 	return machine().time() - m_start;
 }
 
@@ -225,10 +248,65 @@ attotime emu_timer::remaining() const
 	attotime curtime = machine().time();
 	if (curtime >= m_expire)
 		return attotime::zero;
+
+	// partway through a batch, report the time to the next period boundary
+	if (m_periods > 1)
+		return attotime(0, m_period.attoseconds - (curtime - m_start).as_attoseconds() % m_period.attoseconds);
 	return m_expire - curtime;
 }
 
 
+//-------------------------------------------------
+//  catch_up - deliver the periods of a batched
+//  timer that have already elapsed, so that
+//  state kept by the callback is current
+//-------------------------------------------------
+
+void emu_timer::catch_up()
+{
+	// only a batched timer partway through a batch has anything to deliver
+	device_scheduler &scheduler = machine().scheduler();
+	if (!m_enabled || m_periods <= 1 || scheduler.m_callback_timer == this)
+		return;
+
+	// count the whole periods since the last delivery; the final period of
+	// the batch is always left for the scheduler to deliver on expiration
+	attotime curtime = scheduler.time();
+	if (curtime <= m_start)
+		return;
+	UINT32 delivered = (curtime - m_start).as_attoseconds() / m_period.attoseconds;
+	if (delivered == 0)
+		return;
+	delivered = MIN(delivered, m_periods - 1);
+
+	// fire the callback as if we were expiring at the last elapsed boundary,
+	// preserving the state of any callback we were called from
+	attotime boundary = m_start + attotime(0, m_period.attoseconds * delivered);
+	emu_timer *outer_timer = scheduler.m_callback_timer;
+	bool outer_modified = scheduler.m_callback_timer_modified;
+	attotime outer_expire_time = scheduler.m_callback_timer_expire_time;
+	UINT32 left = m_periods - delivered;
+
+	scheduler.m_callback_timer = this;
+	scheduler.m_callback_timer_modified = false;
+	scheduler.m_callback_timer_expire_time = boundary;
+	m_periods = delivered;
+	fire();
+	bool modified = scheduler.m_callback_timer_modified;
+
+	scheduler.m_callback_timer = outer_timer;
+	scheduler.m_callback_timer_modified = outer_modified;
+	scheduler.m_callback_timer_expire_time = outer_expire_time;
+
+	// unless the callback re-adjusted us, the rest of the batch carries on
+	if (!modified)
+	{
+		m_start = boundary;
+		m_periods = left;
+	}
+}
+
+
 //-------------------------------------------------
 //  register_save - register ourself with the save
 //  state system
@@ -274,14 +352,44 @@ void emu_timer::register_save()
 
 inline void emu_timer::schedule_next_period()
 {
-	// advance by one period
+	// advance by one period, or by as many as we batch as long as the whole
+	// batch stays under a second
 	m_start = m_expire;
-	m_expire += m_period;
+	m_periods = 1;
+	if (m_batch > 1 && m_period.seconds == 0 && m_period.attoseconds != 0)
+		m_periods = MIN(m_batch, (ATTOSECONDS_PER_SECOND - 1) / m_period.attoseconds);
+	if (m_periods > 1)
+		m_expire += attotime(0, m_period.attoseconds * m_periods);
+	else
+		m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the queue
+	machine().scheduler().timer_queue_update(*this);
+}
+
+
+//-------------------------------------------------
+//  fire - call the callback for the periods
+//  accounted for by this expiration
+//-------------------------------------------------
+
+inline void emu_timer::fire()
+{
+	g_profiler.start(PROFILER_TIMER_CALLBACK);
+	m_stats->m_timer_callbacks++;
+
+	if (m_device != NULL)
+	{
+		LOG(("execute_timers: timer device %s timer %d\n", m_device->name(), m_id));
+		m_device->timer_expired(*this, m_id, m_param, m_ptr);
+	}
+	else if (!m_callback.isnull())
+	{
+		LOG(("execute_timers: timer callback %s\n", m_callback.name()));
+		m_callback(m_ptr, m_param);
+	}
+
+	g_profiler.stop();
 }
 
 
@@ -292,7 +400,7 @@ inline void emu_timer::schedule_next_period()
 
 void emu_timer::dump() const
 {
-	logerror("%p: en=%d temp=%d exp=%15s start=%15s per=%15s param=%d ptr=%p", this, m_enabled, m_temporary, m_expire.as_string(), m_start.as_string(), m_period.as_string(), m_param, m_ptr);
+	logerror("%p: en=%d temp=%d exp=%15s start=%15s per=%15s batch=%d/%d param=%d ptr=%p", this, m_enabled, m_temporary, m_expire.as_string(), m_start.as_string(), m_period.as_string(), m_periods, m_batch, m_param, m_ptr);
 	if (m_device == NULL)
 		logerror(" cb=%s\n", m_callback.name());
 	else
@@ -315,6 +423,7 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(NULL),
 	m_basetime(attotime::zero),
 	m_timer_list(NULL),
+	m_timer_sequence(0),
 	m_timer_allocator(machine.respool()),
 	m_callback_timer(NULL),
 	m_callback_timer_modified(false),
@@ -324,9 +433,18 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_quantum_allocator(machine.respool()),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
+	// allocate statistics for every device, plus a final entry for the machine itself
+	device_iterator iter(machine.root_device());
+	m_stats.resize_and_clear(iter.count() + 1);
+	int index = 0;
+	for (device_t *device = iter.first(); device != NULL; device = iter.next(), index++)
+	{
+		m_stats[index].m_device = device;
+		m_stats_map.add(device->tag(), &m_stats[index]);
+	}
+
 	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true);
-	m_timer_list->adjust(attotime::never);
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -426,14 +544,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < next_timer().m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target = m_basetime + attotime(0, m_quantum_list.first()->m_actual);
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (next_timer().m_expire < target)
+			target = next_timer().m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string()));
@@ -471,6 +589,7 @@ void device_scheduler::timeslice()
 						// note that this global variable cycles_stolen can be modified
 						// via the call to cpu_execute
 						exec->m_cycles_stolen = 0;
+						exec->m_stats->m_timeslices++;
 						m_executing_device = exec;
 						*exec->m_icountptr = exec->m_cycles_running;
 						if (!call_debugger)
@@ -487,6 +606,7 @@ void device_scheduler::timeslice()
 						ran -= *exec->m_icountptr;
 						assert(ran >= exec->m_cycles_stolen);
 						ran -= exec->m_cycles_stolen;
+						exec->m_stats->m_cycles += ran;
 						g_profiler.stop();
 					}
 
@@ -563,6 +683,16 @@ void device_scheduler::boost_interleave(attotime timeslice_time, attotime boost_
 	// ignore timeslices > 1 second
 	if (timeslice_time.seconds > 0)
 		return;
+
+	// charge the request to whoever is running: a timer callback, a device, or the machine
+	device_execute_interface *executing = currently_executing();
+	if (m_callback_timer != NULL)
+		m_callback_timer->m_stats->m_boosts++;
+	else if (executing != NULL)
+		executing->m_stats->m_boosts++;
+	else
+		machine_stats().m_boosts++;
+
 	add_scheduling_quantum(timeslice_time, boost_duration);
 }
 
@@ -654,6 +784,22 @@ void device_scheduler::timed_trigger(void *ptr, INT32 param)
 
 void device_scheduler::presave()
 {
+	// batches aren't saved: timers partway through one deliver the periods
+	// that have elapsed and shrink the rest of the batch to a single period
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != NULL; timer = next)
+	{
+		next = timer->next();
+		if (timer->m_periods > 1)
+			timer->catch_up();
+		if (timer->m_periods > 1)
+		{
+			timer->m_expire = timer->m_start + timer->m_period;
+			timer->m_periods = 1;
+			timer_queue_update(*timer);
+		}
+	}
+
 	// report the timer state after a log
 	logerror("Prior to saving state:\n");
 	dump_timers();
@@ -666,25 +812,21 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != NULL)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != NULL; timer = next)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
+		next = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 
-		// permanent ones get added to our private list
+		// every saved timer was down to a single period (see presave)
 		else
-			private_list.append(timer_list_remove(timer));
+			timer->m_periods = 1;
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != NULL)
-		timer_list_insert(*timer);
+	// the permanent ones have new expiration times, so re-sort them
+	timer_queue_rebuild();
 
 	m_suspend_changes_pending = true;
 
@@ -808,55 +950,36 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_list_insert - add a new timer to the
+//  list of all timers, and queue it if enabled
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	attotime expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = NULL;
-	for (emu_timer *curtimer = m_timer_list; curtimer != NULL; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != NULL)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != NULL)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = NULL;
+	// the list is unordered, so just link in at the head
+	timer.m_prev = NULL;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != NULL)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// enabled timers also go into the expiration queue
+	timer_queue_update(timer);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the queue
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
+	// pull it out of the expiration queue first
+	if (m_timer_queue.contains(timer))
+		m_timer_queue.remove(timer);
+
 	// remove it from the list
 	if (timer.m_prev != NULL)
 		timer.m_prev->m_next = timer.m_next;
@@ -870,19 +993,66 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 }
 
 
+//-------------------------------------------------
+//  timer_queue_update - place a timer at the
+//  appropriate location in the expiration queue
+//  after its enable state or expiration changed
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_update(emu_timer &timer)
+{
+	// disabled timers can't fire, so keep them out of the queue entirely
+	if (!timer.m_enabled)
+	{
+		if (m_timer_queue.contains(timer))
+			m_timer_queue.remove(timer);
+		return;
+	}
+
+	// a fresh sequence number sorts us after any timer expiring at the same time
+	timer.m_sequence = m_timer_sequence++;
+	m_timer_queue.update(timer);
+}
+
+
+//-------------------------------------------------
+//  timer_queue_rebuild - rebuild the expiration
+//  queue from scratch
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_rebuild()
+{
+	// sequence numbers aren't saved, so renumber the enabled timers in list
+	// order; timers expiring together then fire in the same order whether
+	// the state was loaded into a fresh session or a running one
+	m_timer_queue.reset();
+	m_timer_sequence = 0;
+	for (emu_timer *timer = m_timer_list; timer != NULL; timer = timer->next())
+	{
+		timer->m_heap_index = -1;
+		if (timer->m_enabled)
+		{
+			timer->m_sequence = m_timer_sequence++;
+			m_timer_queue.append(*timer);
+		}
+	}
+	m_timer_queue.reorder();
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(), m_timer_list->m_expire.as_string()));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(), next_timer().m_expire.as_string()));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (next_timer().m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = next_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -894,22 +1064,7 @@ inline void device_scheduler::execute_timers()
 
 		// call the callback
 		if (was_enabled)
-		{
-			g_profiler.start(PROFILER_TIMER_CALLBACK);
-
-			if (timer.m_device != NULL)
-			{
-				LOG(("execute_timers: timer device %s timer %d\n", timer.m_device->name(), timer.m_id));
-				timer.m_device->timer_expired(timer, timer.m_id, timer.m_param, timer.m_ptr);
-			}
-			else if (!timer.m_callback.isnull())
-			{
-				LOG(("execute_timers: timer callback %s\n", timer.m_callback.name()));
-				timer.m_callback(timer.m_ptr, timer.m_param);
-			}
-
-			g_profiler.stop();
-		}
+			timer.fire();
 
 		// clear the callback timer global
 		m_callback_timer = NULL;
@@ -985,3 +1140,42 @@ void device_scheduler::dump_timers() const
 		timer->dump();
 	logerror("=============================================\n");
 }
+
+
+//-------------------------------------------------
+//  stats_text - format the per-device statistics
+//  as a table
+//-------------------------------------------------
+
+const char *device_scheduler::stats_text(astring &string) const
+{
+	string.printf("%-24s %14s %10s %10s %8s %10s %10s %10s\n", "Device", "Cycles", "Slices", "Aborts", "Boosts", "Triggers", "Suspends", "Timers");
+	for (int index = 0; index < m_stats.count(); index++)
+	{
+		// skip devices that never did anything
+		const scheduler_device_stats &stats = m_stats[index];
+		if (stats.m_cycles == 0 && stats.m_timeslices == 0 && stats.m_aborts == 0 && stats.m_boosts == 0 && stats.m_triggers == 0 && stats.m_suspends == 0 && stats.m_timer_callbacks == 0)
+			continue;
+
+		string.catprintf("%-24s %14s", (stats.m_device != NULL) ? stats.m_device->tag() : "(machine)", core_i64_format(stats.m_cycles, 0, false));
+		string.catprintf(" %10s", core_i64_format(stats.m_timeslices, 0, false));
+		string.catprintf(" %10s", core_i64_format(stats.m_aborts, 0, false));
+		string.catprintf(" %8s", core_i64_format(stats.m_boosts, 0, false));
+		string.catprintf(" %10s", core_i64_format(stats.m_triggers, 0, false));
+		string.catprintf(" %10s", core_i64_format(stats.m_suspends, 0, false));
+		string.catprintf(" %10s\n", core_i64_format(stats.m_timer_callbacks, 0, false));
+	}
+	return string;
+}
+
+
+//-------------------------------------------------
+//  dump_stats - print the per-device statistics
+//  at exit
+//-------------------------------------------------
+
+void device_scheduler::dump_stats()
+{
+	astring string;
+	mame_printf_info("Scheduler statistics after %s seconds:\n%s", time().as_string(3), stats_text(string));
+}
@@ -47,6 +47,22 @@ typedef delegate<void (void *, INT32)> timer_expired_delegate;
 typedef void (*timer_expired_func)(running_machine &machine, void *ptr, INT32 param);
 
 
+// ======================> scheduler_device_stats
+
+// counters the scheduler keeps for each device
+struct scheduler_device_stats
+{
+	device_t *          m_device;           // device these apply to, or NULL for the machine
+	UINT64              m_cycles;           // cycles actually executed
+	UINT64              m_timeslices;       // number of times the device was run
+	UINT64              m_aborts;           // timeslices cut short by abort_timeslice
+	UINT64              m_boosts;           // boost_interleave requests
+	UINT64              m_triggers;         // trigger events that resumed the device
+	UINT64              m_suspends;         // suspend requests
+	UINT64              m_timer_callbacks;  // timer callbacks fired
+};
+
+
 // ======================> emu_timer
 
 class emu_timer
@@ -55,6 +71,7 @@ class emu_timer
 	friend class simple_list<emu_timer>;
 	friend class fixed_allocator<emu_timer>;
 	friend class resource_pool_object<emu_timer>;
+	friend class indexed_heap<emu_timer>;
 
 	// construction/destruction
 	emu_timer();
@@ -82,6 +99,14 @@ public:
 	void reset(attotime duration = attotime::never) { adjust(duration, m_param, m_period); }
 	void adjust(attotime duration, INT32 param = 0, attotime periodicity = attotime::never);
 
+	// periodic batching; a batched timer fires once for up to N periods and
+	// reports how many elapsed, and observers call catch_up() before looking
+	// at state the callback maintains
+	void set_batch(UINT32 periods) { m_batch = MAX(periods, 1); }
+	UINT32 batch() const { return m_batch; }
+	UINT32 periods() const { return m_periods; }
+	void catch_up();
+
 	// timing queries
 	attotime elapsed() const;
 	attotime remaining() const;
@@ -92,12 +117,16 @@ private:
 	// internal helpers
 	void register_save();
 	void schedule_next_period();
+	void fire();
 	void dump() const;
+	bool heap_before(const emu_timer &other) const { return (m_expire < other.m_expire || (m_expire == other.m_expire && m_sequence < other.m_sequence)); }
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	int                 m_heap_index;   // index within the expiration queue, or -1 if not queued
+	UINT64              m_sequence;     // queue sequence number, for ordering timers that expire together
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -106,8 +135,11 @@ private:
 	attotime            m_period;       // the repeat frequency of the timer
 	attotime            m_start;        // time when the timer was started
 	attotime            m_expire;       // time when the timer will expire
+	UINT32              m_batch;        // maximum number of periods coalesced into one callback
+	UINT32              m_periods;      // number of periods the next callback accounts for
 	device_t *          m_device;       // for device timers, a pointer to the device
 	device_timer_id     m_id;           // for device timers, the ID of the timer
+	scheduler_device_stats *m_stats;    // statistics to charge our callbacks to
 };
 
 
@@ -153,6 +185,12 @@ public:
 	emu_timer *timer_alloc(device_t &device, device_timer_id id = 0, void *ptr = NULL);
 	void timer_set(attotime duration, device_t &device, device_timer_id id = 0, int param = 0, void *ptr = NULL);
 
+	// statistics
+	scheduler_device_stats *stats(device_t &device) const { return m_stats_map.find(device.tag()); }
+	scheduler_device_stats &machine_stats() { return m_stats[m_stats.count() - 1]; }
+	const char *stats_text(astring &string) const;
+	void dump_stats();
+
 	// debugging
 	void dump_timers() const;
 
@@ -174,16 +212,23 @@ private:
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &next_timer() const { return m_timer_queue.head(); }
 	void execute_timers();
 
+	// expiration queue helpers
+	void timer_queue_update(emu_timer &timer);
+	void timer_queue_rebuild();
+
 	// internal state
 	running_machine &           m_machine;                  // reference to our machine
 	device_execute_interface *  m_executing_device;         // pointer to currently executing device
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// list of allocated timers, plus a binary min-heap of the enabled ones
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	indexed_heap<emu_timer>     m_timer_queue;              // enabled timers, ordered by expiration time
+	UINT64                      m_timer_sequence;           // next sequence number to hand out
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -192,6 +237,10 @@ private:
 	attotime                    m_callback_timer_expire_time; // the original expiration time
 	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
 
+	// statistics, one entry per device plus one for the machine
+	dynamic_array<scheduler_device_stats> m_stats;          // per-device counters, in device order
+	tagmap_t<scheduler_device_stats *> m_stats_map;         // map from device tag to counters
+
 	// scheduling quanta
 	class quantum_slot
 	{
@@ -55,6 +55,7 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_yscale(1.0f),
 		m_palette_tag(NULL),
 		m_palette_base(0),
+		m_coalesce_updates(false),
 		m_container(NULL),
 		m_width(100),
 		m_height(100),
@@ -64,6 +65,7 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_curtexture(0),
 		m_changed(true),
 		m_last_partial_scan(0),
+		m_deferred_scan(-1),
 		m_frame_period(DEFAULT_FRAME_PERIOD.as_attoseconds()),
 		m_scantime(1),
 		m_pixeltime(1),
@@ -228,6 +230,18 @@ void screen_device::static_set_palette(device_t &device, const char *palette, in
 }
 
 
+//-------------------------------------------------
+//  static_set_coalesce_updates - configure
+//  whether partial updates are deferred until
+//  the driver calls update_deferred()
+//-------------------------------------------------
+
+void screen_device::static_set_coalesce_updates(device_t &device, bool coalesce)
+{
+	downcast<screen_device &>(device).m_coalesce_updates = coalesce;
+}
+
+
 //-------------------------------------------------
 //  device_validity_check - verify device
 //  configuration
@@ -366,6 +380,10 @@ void screen_device::device_start()
 	save_item(NAME(m_vblank_start_time));
 	save_item(NAME(m_vblank_end_time));
 	save_item(NAME(m_frame_number));
+
+	// deferred scanlines are not part of the saved state, so draw them first
+	if (m_coalesce_updates)
+		machine().save().register_presave(save_prepost_delegate(FUNC(screen_device::update_deferred), this));
 }
 
 
@@ -390,6 +408,7 @@ void screen_device::device_stop()
 
 void screen_device::device_post_load()
 {
+	m_deferred_scan = -1;
 	realloc_screen_bitmaps();
 }
 
@@ -451,6 +470,9 @@ void screen_device::configure(int width, int height, const rectangle &visarea, a
 	assert(m_type == SCREEN_TYPE_VECTOR || visarea.min_y < height);
 	assert(frame_period > 0);
 
+	// draw anything deferred with the old parameters
+	update_deferred();
+
 	// fill in the new parameters
 	m_width = width;
 	m_height = height;
@@ -588,12 +610,33 @@ bool screen_device::update_partial(int scanline)
 	}
 
 	// skip if less than the lowest so far
-	if (scanline < m_last_partial_scan)
+	if (scanline < m_last_partial_scan || scanline <= m_deferred_scan)
 	{
 		LOG_PARTIAL_UPDATES(("skipped because less than previous\n"));
 		return FALSE;
 	}
 
+	// when coalescing, just remember how far we got; the scanlines are drawn
+	// together by update_deferred() or once we reach the bottom of the screen
+	if (m_coalesce_updates && scanline < m_visarea.max_y)
+	{
+		LOG_PARTIAL_UPDATES(("deferred\n"));
+		m_deferred_scan = scanline;
+		return FALSE;
+	}
+	m_deferred_scan = -1;
+	return draw_partial(scanline);
+}
+
+
+//-------------------------------------------------
+//  draw_partial - call the screen update callback
+//  from the last scanline drawn up to and
+//  including the specified scanline
+//-------------------------------------------------
+
+bool screen_device::draw_partial(int scanline)
+{
 	// set the start/end scanlines
 	rectangle clip = m_visarea;
 	if (m_last_partial_scan > clip.min_y)
@@ -657,6 +700,23 @@ void screen_device::update_now()
 }
 
 
+//-------------------------------------------------
+//  update_deferred - draw any scanlines held back
+//  by coalescing, using the current state
+//-------------------------------------------------
+
+void screen_device::update_deferred()
+{
+	if (m_deferred_scan >= 0)
+	{
+		LOG_PARTIAL_UPDATES(("Partial: flushing deferred update(%s, %d): ", tag(), m_deferred_scan));
+		int scanline = m_deferred_scan;
+		m_deferred_scan = -1;
+		draw_partial(scanline);
+	}
+}
+
+
 //-------------------------------------------------
 //  reset_partial_updates - reset the partial
 //  updating state
@@ -665,6 +725,7 @@ void screen_device::update_now()
 void screen_device::reset_partial_updates()
 {
 	m_last_partial_scan = 0;
+	m_deferred_scan = -1;
 	m_partial_updates_this_frame = 0;
 	m_scanline0_timer->adjust(time_until_pos(0));
 }
@@ -862,6 +923,9 @@ void screen_device::vblank_end()
 
 bool screen_device::update_quads()
 {
+	// the bitmap is about to be handed to the renderer
+	update_deferred();
+
 	// only update if live
 	if (machine().render().is_live(*this))
 	{
@@ -166,6 +166,7 @@ public:
 	static void static_set_screen_update(device_t &device, screen_update_rgb32_delegate callback);
 	static void static_set_screen_vblank(device_t &device, screen_vblank_delegate callback);
 	static void static_set_palette(device_t &device, const char *palette, int base);
+	static void static_set_coalesce_updates(device_t &device, bool coalesce);
 
 	// information getters
 	render_container &container() const { assert(m_container != NULL); return *m_container; }
@@ -197,6 +198,7 @@ public:
 	bool update_partial(int scanline);
 	void update_now();
 	void reset_partial_updates();
+	void update_deferred();
 
 	// additional helpers
 	void register_vblank_callback(vblank_state_delegate vblank_callback);
@@ -231,6 +233,7 @@ private:
 	// internal helpers
 	void set_container(render_container &container) { m_container = &container; }
 	void realloc_screen_bitmaps();
+	bool draw_partial(int scanline);
 	void vblank_begin();
 	void vblank_end();
 	void finalize_burnin();
@@ -248,6 +251,7 @@ private:
 	screen_vblank_delegate m_screen_vblank;         // screen vblank callback
 	const char *		m_palette_tag;				// tag to our palette
 	int					m_palette_base;				// base of our palette
+	bool                m_coalesce_updates;         // defer partial updates until update_deferred()
 
 	// internal state
 	render_container *  m_container;                // pointer to our container
@@ -268,6 +272,7 @@ private:
 	UINT8               m_curtexture;               // current texture index
 	bool                m_changed;                  // has this bitmap changed?
 	INT32               m_last_partial_scan;        // scanline of last partial update
+	INT32               m_deferred_scan;            // last scanline of deferred partial updates, or -1
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
 	UINT32              m_unique_id;                // unique id for this screen_device
 
@@ -369,6 +374,12 @@ typedef device_type_iterator<&device_creator<screen_device>, screen_device> scre
 #define MCFG_SCREEN_PALETTE(_palette_tag) \
 	screen_device::static_set_palette(*device, _palette_tag, 0);
 
+// partial updates are deferred and drawn together until the driver calls
+// update_deferred(), which it must do before changing anything that
+// affects how the screen update callback draws
+#define MCFG_SCREEN_COALESCE_UPDATES() \
+	screen_device::static_set_coalesce_updates(*device, true);
+
 
 
 //**************************************************************************
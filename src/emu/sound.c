@@ -14,6 +14,12 @@
 #include "config.h"
 #include "sound/wavwrite.h"
 
+// use SSE2 on 64-bit implementations, where it can be assumed
+#if (defined(__SSE2__) && defined(PTR64))
+#define SOUND_SSE2
+#include <emmintrin.h>
+#endif
+
 
 
 //**************************************************************************
@@ -27,16 +33,75 @@
 
 
 //**************************************************************************
-//  CONSTANTS
+//  GLOBAL VARIABLES
 //**************************************************************************
 
+const attotime sound_manager::STREAMS_UPDATE_ATTOTIME = attotime::from_hz(STREAMS_UPDATE_FREQUENCY);
+
 
 
 //**************************************************************************
-//  GLOBAL VARIABLES
+//  INLINE FUNCTIONS
 //**************************************************************************
 
-const attotime sound_manager::STREAMS_UPDATE_ATTOTIME = attotime::from_hz(STREAMS_UPDATE_FREQUENCY);
+//-------------------------------------------------
+//  clamp_and_interleave - clamp the left and right
+//  mixes to 16 bits and interleave them
+//-------------------------------------------------
+
+inline void clamp_and_interleave(INT16 *dest, const INT32 *left, const INT32 *right, int samples)
+{
+	int sample = 0;
+#ifdef SOUND_SSE2
+	// the saturating pack does the clamping, eight samples per side at a time
+	for ( ; sample + 8 <= samples; sample += 8)
+	{
+		__m128i leftpack = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&left[sample])), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&left[sample + 4])));
+		__m128i rightpack = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&right[sample])), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&right[sample + 4])));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[sample * 2]), _mm_unpacklo_epi16(leftpack, rightpack));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[sample * 2 + 8]), _mm_unpackhi_epi16(leftpack, rightpack));
+	}
+#endif
+	for ( ; sample < samples; sample++)
+	{
+		INT32 samp = left[sample];
+		dest[sample * 2 + 0] = (samp < -32768) ? -32768 : (samp > 32767) ? 32767 : samp;
+		samp = right[sample];
+		dest[sample * 2 + 1] = (samp < -32768) ? -32768 : (samp > 32767) ? 32767 : samp;
+	}
+}
+
+
+//-------------------------------------------------
+//  find_stream_index - return the index of a
+//  stream within an array of streams
+//-------------------------------------------------
+
+static int find_stream_index(const dynamic_array<sound_stream *> &streams, const sound_stream *stream)
+{
+	for (int index = 0; index < streams.count(); index++)
+		if (streams[index] == stream)
+			return index;
+	assert(false);
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  find_stream_set - return the representative
+//  of the set containing a stream, compressing
+//  the path along the way
+//-------------------------------------------------
+
+static int find_stream_set(dynamic_array<int> &parent, int index)
+{
+	while (parent[index] != index)
+	{
+		parent[index] = parent[parent[index]];
+		index = parent[index];
+	}
+	return index;
+}
 
 
 
@@ -240,6 +305,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// update the dependent info
 	if (input.m_source != NULL)
 		input.m_source->m_dependents++;
+	m_device.machine().sound().m_graph_dirty = true;
 
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
@@ -468,9 +534,24 @@ void sound_stream::recompute_sample_rate_data()
 			attoseconds_t new_attosecs_per_sample = ATTOSECONDS_PER_SECOND / input.m_source->m_stream->m_sample_rate;
 			attoseconds_t latency = MAX(new_attosecs_per_sample, m_attoseconds_per_sample);
 
+			// a polyphase filter needs half its taps of source beyond the current position,
+			// and as much behind it, so only use one if that fits well within an update
+			input.m_filter = NULL;
+			UINT32 source_rate = input.m_source->m_stream->m_sample_rate;
+			if (m_device.machine().sound().sinc_resample() && resample_filter::usable(source_rate, m_sample_rate))
+			{
+				resample_filter *filter = m_device.machine().sound().find_resample_filter(source_rate, m_sample_rate);
+				attoseconds_t filter_latency = (filter->half_taps() + 1) * new_attosecs_per_sample + m_attoseconds_per_sample;
+				if (filter_latency < update_attoseconds / 2)
+				{
+					input.m_filter = filter;
+					latency = filter_latency;
+				}
+			}
+
 			// if the input stream's sample rate is lower, we will use linear interpolation
 			// this requires an extra sample from the source
-			if (input.m_source->m_stream->m_sample_rate < m_sample_rate)
+			else if (input.m_source->m_stream->m_sample_rate < m_sample_rate)
 				latency += new_attosecs_per_sample;
 
 			// if our sample rates match exactly, we don't need any latency
@@ -634,78 +715,16 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	// compute the stepping fraction
 	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
-	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
+	// with a polyphase filter, convolve the source with the phase nearest our position
+	if (input.m_filter != NULL)
 	{
-		while (numsamples--)
-		{
-			// compute the sample
-			stream_sample_t sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
+		assert(basesample - (input.m_filter->half_taps() - 1) >= input_stream.m_output_base_sampindex);
+		input.m_filter->resample(dest, source, basefrac, step, gain, numsamples);
 	}
 
-	// input is undersampled: point sample except where our sample period covers a boundary
-	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
-
-			// if we're done, we're done
-			if (INT32(numsamples--) < 0)
-				break;
-
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
-
-			// blend between the two samples accordingly
-			stream_sample_t sample = (source[0] * (0x1000 - startfrac) + source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
-	}
-
-	// input is oversampled: sum the energy
+	// otherwise copy, point sample or average depending on the step
 	else
-	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			int remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			int scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			stream_sample_t sample = source[tpos++] * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += source[tpos++] * 0x100;
-				remainder -= 0x100;
-			}
-			sample += source[tpos] * remainder;
-			sample /= smallstep;
-
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
-	}
+		resample_fast(dest, source, basefrac, step, gain, numsamples);
 
 	return input.m_resample;
 }
@@ -723,6 +742,7 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 sound_stream::stream_input::stream_input()
 	: m_source(NULL),
 		m_latency_attoseconds(0),
+		m_filter(NULL),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -765,6 +785,9 @@ sound_manager::sound_manager(running_machine &machine)
 		m_attenuation(0),
 		m_nosound_mode(!machine.options().sound()),
 		m_wavfile(NULL),
+		m_sinc_resample(strcmp(machine.options().resampler(), "sinc") == 0),
+		m_update_queue(NULL),
+		m_graph_dirty(true),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds),
 		m_last_update(attotime::zero)
 {
@@ -798,6 +821,10 @@ sound_manager::sound_manager(running_machine &machine)
 	// set the starting attenuation
 	set_attenuation(machine.options().volume());
 
+	// independent branches of the stream graph can be updated concurrently
+	if (machine.options().sound_parallel())
+		m_update_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// start the periodic update flushing timer
 	m_update_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(sound_manager::update), this));
 	m_update_timer->adjust(STREAMS_UPDATE_ATTOTIME, 0, STREAMS_UPDATE_ATTOTIME);
@@ -814,6 +841,169 @@ sound_manager::~sound_manager()
 	if (m_wavfile != NULL)
 		wav_close(m_wavfile);
 	m_wavfile = NULL;
+
+	// free the work queue
+	if (m_update_queue != NULL)
+		osd_work_queue_free(m_update_queue);
+}
+
+
+//-------------------------------------------------
+//  find_resample_filter - return the polyphase
+//  filter between two rates, building it the
+//  first time it is needed
+//-------------------------------------------------
+
+resample_filter *sound_manager::find_resample_filter(UINT32 inrate, UINT32 outrate)
+{
+	for (resample_filter *filter = m_filter_list.first(); filter != NULL; filter = filter->next())
+		if (filter->input_rate() == inrate && filter->output_rate() == outrate)
+			return filter;
+	return &m_filter_list.append(*global_alloc(resample_filter(inrate, outrate)));
+}
+
+
+//-------------------------------------------------
+//  build_update_graph - split the streams that
+//  feed the speakers into branches which share
+//  no streams, so each can be updated on its own
+//-------------------------------------------------
+
+void sound_manager::build_update_graph()
+{
+	m_graph_dirty = false;
+	m_branch.resize(0);
+	m_branch_roots.resize(0);
+
+	// number the streams, starting each in a set of its own
+	int count = m_stream_list.count();
+	dynamic_array<sound_stream *> streams(count);
+	dynamic_array<int> parent(count);
+	int index = 0;
+	for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next(), index++)
+	{
+		streams[index] = stream;
+		parent[index] = index;
+	}
+
+	// the speakers' mixing streams are where the branches join; the streams
+	// they read from are the roots of the branches
+	dynamic_array<int> roots;
+	for (index = 0; index < count; index++)
+		if (streams[index]->device().type() == SPEAKER)
+			for (int inputnum = 0; inputnum < streams[index]->m_input.count(); inputnum++)
+			{
+				sound_stream::stream_output *source = streams[index]->m_input[inputnum].m_source;
+				if (source == NULL || source->m_stream->device().type() == SPEAKER)
+					continue;
+				int root = find_stream_index(streams, source->m_stream);
+				int rootnum;
+				for (rootnum = 0; rootnum < roots.count(); rootnum++)
+					if (roots[rootnum] == root)
+						break;
+				if (rootnum == roots.count())
+					roots.append(root);
+			}
+
+	// merge everything each root depends upon into its set; a stream already
+	// in the set has had its own inputs visited
+	dynamic_array<int> pending;
+	for (int rootnum = 0; rootnum < roots.count(); rootnum++)
+	{
+		pending.resize(0);
+		pending.append(roots[rootnum]);
+		while (pending.count() > 0)
+		{
+			sound_stream *stream = streams[pending[pending.count() - 1]];
+			pending.resize(pending.count() - 1);
+			for (int inputnum = 0; inputnum < stream->m_input.count(); inputnum++)
+				if (stream->m_input[inputnum].m_source != NULL)
+				{
+					int source = find_stream_index(streams, stream->m_input[inputnum].m_source->m_stream);
+					int sourceset = find_stream_set(parent, source);
+					int rootset = find_stream_set(parent, roots[rootnum]);
+					if (sourceset != rootset)
+					{
+						parent[sourceset] = rootset;
+						pending.append(source);
+					}
+				}
+		}
+	}
+
+	// a set containing any stream whose device has not opted in to parallel
+	// updates is left for its speakers to pull on the main thread
+	dynamic_array<bool> serialset(count, 0);
+	for (index = 0; index < count; index++)
+	{
+		device_sound_interface *sound;
+		if (!streams[index]->device().interface(sound) || !sound->parallel_update())
+			serialset[find_stream_set(parent, index)] = true;
+	}
+
+	// gather the roots of each remaining set into a branch, in speaker order
+	dynamic_array<int> branchset;
+	for (int rootnum = 0; rootnum < roots.count(); rootnum++)
+	{
+		int rootset = find_stream_set(parent, roots[rootnum]);
+		if (serialset[rootset])
+			continue;
+		int branchnum;
+		for (branchnum = 0; branchnum < branchset.count(); branchnum++)
+			if (branchset[branchnum] == rootset)
+				break;
+		if (branchnum == branchset.count())
+			branchset.append(rootset);
+	}
+	m_branch.resize(branchset.count());
+	for (int branchnum = 0; branchnum < branchset.count(); branchnum++)
+	{
+		m_branch[branchnum].m_count = 0;
+		for (int rootnum = 0; rootnum < roots.count(); rootnum++)
+			if (find_stream_set(parent, roots[rootnum]) == branchset[branchnum])
+			{
+				m_branch_roots.append(streams[roots[rootnum]]);
+				m_branch[branchnum].m_count++;
+			}
+	}
+
+	// point each branch at its roots now that the array won't move again
+	sound_stream **roots_base = m_branch_roots;
+	for (int branchnum = 0; branchnum < m_branch.count(); branchnum++)
+	{
+		m_branch[branchnum].m_roots = roots_base;
+		roots_base += m_branch[branchnum].m_count;
+	}
+	VPRINTF(("sound graph: %d streams, %d roots, %d branches\n", count, roots.count(), m_branch.count()));
+}
+
+
+//-------------------------------------------------
+//  update_branches - update every branch to the
+//  current time on the work queue, and wait for
+//  them all to finish
+//-------------------------------------------------
+
+void sound_manager::update_branches()
+{
+	// the speakers mix straight from the branch outputs once this returns
+	osd_work_item_run_multiple(m_update_queue, update_branch_callback, m_branch.count(), &m_branch[0], sizeof(m_branch[0]));
+}
+
+
+//-------------------------------------------------
+//  update_branch_callback - bring the streams of
+//  a single branch up to the current time; each
+//  stream generates exactly the samples it would
+//  have when pulled by its speaker
+//-------------------------------------------------
+
+void *sound_manager::update_branch_callback(void *param, int threadid)
+{
+	update_branch &branch = *reinterpret_cast<update_branch *>(param);
+	for (int rootnum = 0; rootnum < branch.m_count; rootnum++)
+		branch.m_roots[rootnum]->update();
+	return NULL;
 }
 
 
@@ -823,6 +1013,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, void *param, sound_stream::stream_update_func callback)
 {
+	m_graph_dirty = true;
 	if (callback != NULL)
 		return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, param, callback)));
 	else
@@ -988,6 +1179,16 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring the independent branches feeding the speakers up to date concurrently;
+	// the profiler isn't thread-safe, so don't do this while it is running
+	if (m_update_queue != NULL && !g_profiler.enabled())
+	{
+		if (m_graph_dirty)
+			build_update_graph();
+		if (m_branch.count() > 1)
+			update_branches();
+	}
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	speaker_device_iterator iter(machine().root_device());
@@ -998,28 +1199,38 @@ void sound_manager::update(void *ptr, int param)
 	UINT32 finalmix_step = machine().video().speed_factor();
 	UINT32 finalmix_offset = 0;
 	INT16 *finalmix = m_finalmix;
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+
+	// at normal speed every sample is used in order, so clamp them in bulk
+	if (finalmix_step == 1000 && m_finalmix_leftover < 1000)
 	{
-		int sampindex = sample / 1000;
-
-		// clamp the left side
-		INT32 samp = m_leftmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
-
-		// clamp the right side
-		samp = m_rightmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
+		clamp_and_interleave(finalmix, m_leftmix, m_rightmix, samples_this_update);
+		finalmix_offset = samples_this_update * 2;
+	}
+	else
+	{
+		int sample;
+		for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+		{
+			int sampindex = sample / 1000;
+
+			// clamp the left side
+			INT32 samp = m_leftmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+
+			// clamp the right side
+			samp = m_rightmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+		}
+		m_finalmix_leftover = sample - samples_this_update * 1000;
 	}
-	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
 	if (finalmix_offset > 0)
@@ -79,15 +79,16 @@ class sound_stream
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		dynamic_array<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		resample_filter *   m_filter;               // polyphase filter, or NULL for the fast resampler
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
 	};
 
 	// constants
 	static const int OUTPUT_BUFFER_UPDATES      = 5;
-	static const UINT32 FRAC_BITS               = 22;
-	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
-	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
+	static const UINT32 FRAC_BITS               = RESAMPLE_FRAC_BITS;
+	static const UINT32 FRAC_ONE                = RESAMPLE_FRAC_ONE;
+	static const UINT32 FRAC_MASK               = RESAMPLE_FRAC_MASK;
 
 	// construction/destruction
 	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, void *param = NULL, stream_update_func callback = &sound_stream::device_stream_update_stub);
@@ -197,6 +198,8 @@ public:
 	attotime last_update() const { return m_last_update; }
 	attoseconds_t update_attoseconds() const { return m_update_attoseconds; }
 
+	bool sinc_resample() const { return m_sinc_resample; }
+
 	// stream creation
 	sound_stream *stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, void *param = NULL, sound_stream::stream_update_func callback = NULL);
 
@@ -220,6 +223,17 @@ private:
 	void config_save(int config_type, xml_data_node *parentnode);
 
 	void update(void *ptr = NULL, INT32 param = 0);
+	resample_filter *find_resample_filter(UINT32 inrate, UINT32 outrate);
+	void build_update_graph();
+	void update_branches();
+	static void *update_branch_callback(void *param, int threadid);
+
+	// a group of streams that shares nothing with the others feeding the speakers
+	struct update_branch
+	{
+		sound_stream **     m_roots;                // streams feeding the speakers directly
+		int                 m_count;                // number of roots
+	};
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -236,6 +250,16 @@ private:
 
 	wav_file *          m_wavfile;
 
+	// resampling
+	bool                m_sinc_resample;        // use polyphase filters between stream rates
+	simple_list<resample_filter> m_filter_list; // filters built so far
+
+	// parallel updates
+	osd_work_queue *    m_update_queue;         // queue for updating branches, or NULL to update serially
+	bool                m_graph_dirty;          // streams or links have changed since the branches were built
+	dynamic_array<update_branch> m_branch;      // independent branches of the stream graph
+	dynamic_array<sound_stream *> m_branch_roots; // roots of all branches, grouped by branch
+
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
@@ -26,6 +26,8 @@ ym2151_device::ym2151_device(const machine_config &mconfig, const char *tag, dev
 		m_irqhandler(*this),
 		m_portwritehandler(*this)
 {
+	// operators, LFO and noise are per chip, and the timers are emulated by the scheduler
+	m_parallel_update = true;
 }
 
 
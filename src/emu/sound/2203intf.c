@@ -208,6 +208,8 @@ ym2203_device::ym2203_device(const machine_config &mconfig, const char *tag, dev
 		m_irq_handler(*this),
 		m_ay8910_config(NULL)
 {
+	// both the FM and SSG streams belong to this chip; only the timers raise interrupts
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
@@ -80,6 +80,8 @@ ym2413_device::ym2413_device(const machine_config &mconfig, const char *tag, dev
 	: device_t(mconfig, YM2413, "YM2413", tag, owner, clock, "ym2413", __FILE__),
 		device_sound_interface(mconfig, *this)
 {
+	// the instrument ROM and tables are read-only once the chip has started
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
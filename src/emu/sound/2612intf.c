@@ -153,6 +153,8 @@ ym2612_device::ym2612_device(const machine_config &mconfig, const char *tag, dev
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	// the FM channels and the DAC write only this chip's state
+	m_parallel_update = true;
 }
 
 ym2612_device::ym2612_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source)
@@ -160,6 +162,7 @@ ym2612_device::ym2612_device(const machine_config &mconfig, device_type type, co
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
@@ -140,6 +140,8 @@ ymf262_device::ymf262_device(const machine_config &mconfig, const char *tag, dev
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	// status and IRQ only change on timer expiry or register writes
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
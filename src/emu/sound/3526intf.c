@@ -158,6 +158,8 @@ ym3526_device::ym3526_device(const machine_config &mconfig, const char *tag, dev
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	// no ADPCM unit, so the update never raises the IRQ
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
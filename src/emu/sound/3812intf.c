@@ -156,6 +156,8 @@ ym3812_device::ym3812_device(const machine_config &mconfig, const char *tag, dev
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	// the OPL core shares only lookup tables, which are filled in at startup
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
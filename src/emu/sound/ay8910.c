@@ -1086,11 +1086,14 @@ ay8910_device::ay8910_device(const machine_config &mconfig, const char *tag, dev
 	: device_t(mconfig, AY8910, "AY-3-8910A", tag, owner, clock, "ay8910", __FILE__),
 		device_sound_interface(mconfig, *this)
 {
+	// tone, noise and envelope generation only use this chip's registers
+	m_parallel_update = true;
 }
 ay8910_device::ay8910_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source)
 	: device_t(mconfig, type, name, tag, owner, clock, shortname, source),
 		device_sound_interface(mconfig, *this)
 {
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
@@ -30,6 +30,8 @@ dac_device::dac_device(const machine_config &mconfig, const char *tag, device_t
 		m_stream(NULL),
 		m_output(0)
 {
+	// the stream just repeats the last value written
+	m_parallel_update = true;
 }
 
 
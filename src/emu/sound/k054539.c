@@ -20,6 +20,8 @@ k054539_device::k054539_device(const machine_config &mconfig, const char *tag, d
 		device_sound_interface(mconfig, *this),
 		m_timer_handler(*this)
 {
+	// channel and reverb state live in our registers and RAM; the timer is separate
+	m_parallel_update = true;
 }
 
 
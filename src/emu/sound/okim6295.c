@@ -96,6 +96,8 @@ okim6295_device::okim6295_device(const machine_config &mconfig, const char *tag,
 		m_pin7_state(0),
 		m_direct(NULL)
 {
+	// voices fetch ADPCM through our own address space, which only the CPU rebanks
+	m_parallel_update = true;
 }
 
 
@@ -138,6 +138,8 @@ sn76496_base_device::sn76496_base_device(const machine_config &mconfig, device_t
 	m_clock_divider(clockdivider),
 	m_freq0_is_max(freq0)
 {
+	// the counters and noise LFSR are all per chip
+	m_parallel_update = true;
 }
 
 void sn76496_base_device::device_start()
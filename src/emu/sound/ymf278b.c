@@ -1006,6 +1006,8 @@ ymf278b_device::ymf278b_device(const machine_config &mconfig, const char *tag, d
 		device_sound_interface(mconfig, *this),
 		m_irq_handler(*this)
 {
+	// wave playback reads only the sample ROM and our slots
+	m_parallel_update = true;
 }
 
 //-------------------------------------------------
@@ -391,6 +391,11 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, tilemap_get_info_delegate t
 	m_dy = 0;
 	m_dy_flipped = 0;
 
+	// change tracking is opt-in
+	m_track_changes = false;
+	m_drawn_count = 0;
+	m_draw_sequence = 0;
+
 	// allocate pixmap
 	m_pixmap.allocate(m_width, m_height);
 
@@ -750,6 +755,11 @@ g_profiler.start(PROFILER_TILEMAP_UPDATE);
 	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && m_tileinfo.mask_data != NULL)
 		m_tileflags[logindex] = tile_apply_bitmask(m_tileinfo.mask_data, x0, y0, m_tileinfo.category, flags);
 
+	// remember that this part of the pixmap changed since each tracked draw
+	if (m_track_changes)
+		for (int recnum = 0; recnum < m_drawn_count; recnum++)
+			add_dirty_rect(m_drawn[recnum].pixmap_dirty, rectangle(x0, x0 + m_tilewidth - 1, y0, y0 + m_tileheight - 1));
+
 	// track which gfx have been used for this tilemap
 	if (m_tileinfo.gfxnum != 0xff && (m_gfx_used & (1 << m_tileinfo.gfxnum)) == 0)
 	{
@@ -885,6 +895,7 @@ void tilemap_t::configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &pr
 	// set the priority code and alpha
 	blit.tilemap_priority_code = priority | (priority_mask << 8) | (m_palette_offset << 16);
 	blit.alpha = (flags & TILEMAP_DRAW_ALPHA_FLAG) ? (flags >> 24) : 0xff;
+	blit.tiles_only = false;
 
 	// tile priority; unless otherwise specified, draw anything in layer 0
 	blit.mask = TILEMAP_PIXEL_CATEGORY_MASK;
@@ -923,9 +934,16 @@ void tilemap_t::configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &pr
 template<class _BitmapClass>
 void tilemap_t::draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
 {
-	// skip if disabled
+	// skip if disabled; whatever earlier draws produced is gone now
 	if (!m_enable)
+	{
+		if (m_track_changes && m_drawn_count > 0)
+		{
+			add_dirty_rect(m_dirty_rects, cliprect);
+			m_drawn_count = 0;
+		}
 		return;
+	}
 
 g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// configure the blit parameters based on the input parameters
@@ -935,6 +953,71 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
+	// small layers, and every layer unless banding is enabled, are drawn right here
+	int bands = MIN(blit.cliprect.width() * blit.cliprect.height() / MIN_BAND_PIXELS, blit.cliprect.height());
+	bands = MIN(bands, MAX_DRAW_BANDS);
+	osd_work_queue *queue = (bands > 1) ? m_manager->draw_queue() : NULL;
+	if (queue == NULL)
+	{
+		draw_layer(screen, dest, blit);
+		if (m_track_changes)
+			update_dirty_rects(screen, blit, flags);
+g_profiler.stop();
+		return;
+	}
+
+	// the bands only read the tilemap, so first bring the tiles they will read
+	// up to date; tile_update calls back into the driver, which must happen on
+	// this thread
+	blit_parameters tiles = blit;
+	tiles.tiles_only = true;
+	draw_layer(screen, dest, tiles);
+
+	// split the cliprect into horizontal bands; each one touches only its own
+	// rows of the destination and priority bitmaps
+	draw_band band[MAX_DRAW_BANDS];
+	for (int bandnum = 0; bandnum < bands; bandnum++)
+	{
+		band[bandnum].tilemap = this;
+		band[bandnum].screen = &screen;
+		band[bandnum].dest = &dest;
+		band[bandnum].blit = blit;
+		band[bandnum].blit.cliprect.min_y = cliprect.min_y + cliprect.height() * bandnum / bands;
+		band[bandnum].blit.cliprect.max_y = cliprect.min_y + cliprect.height() * (bandnum + 1) / bands - 1;
+	}
+
+	// bands write disjoint rows of dest and priority, and all of them must land
+	// before the caller composites the next layer on top
+	osd_work_item_run_multiple(queue, draw_band_callback<_BitmapClass>, bands, band, sizeof(band[0]));
+	if (m_track_changes)
+		update_dirty_rects(screen, blit, flags);
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_band_callback - draw one band of a layer
+//  on a worker thread
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_t::draw_band_callback(void *param, int threadid)
+{
+	draw_band &band = *reinterpret_cast<draw_band *>(param);
+	band.tilemap->draw_layer(*band.screen, *reinterpret_cast<_BitmapClass *>(band.dest), band.blit);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  draw_layer - draw all the instances of the
+//  tilemap that fall within the blit cliprect,
+//  applying the scroll values
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_layer(screen_device &screen, _BitmapClass &dest, blit_parameters &blit)
+{
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
 	UINT32 width = visarea.min_x + visarea.max_x + 1;
@@ -1025,7 +1108,6 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			}
 		}
 	}
-g_profiler.stop();
 }
 
 void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
@@ -1035,6 +1117,174 @@ void tilemap_t::draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle
 { draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
 
 
+//-------------------------------------------------
+//  set_track_changes - enable or disable change
+//  tracking; enabling starts with every draw
+//  reported as a full change
+//-------------------------------------------------
+
+void tilemap_t::set_track_changes(bool track)
+{
+	m_track_changes = track;
+	m_drawn_count = 0;
+	m_dirty_rects.resize(0);
+}
+
+
+//-------------------------------------------------
+//  dirty - return true if any area changed by
+//  this frame's draws overlaps the given rect
+//-------------------------------------------------
+
+bool tilemap_t::dirty(const rectangle &cliprect) const
+{
+	for (int rectnum = 0; rectnum < m_dirty_rects.count(); rectnum++)
+	{
+		rectangle rect = m_dirty_rects[rectnum];
+		rect &= cliprect;
+		if (!rect.empty())
+			return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  find_draw_record - find the record of the
+//  last draw with the same parameters, or take
+//  over the least recently used one
+//-------------------------------------------------
+
+tilemap_t::draw_record &tilemap_t::find_draw_record(const blit_parameters &blit, UINT32 flags, bool &found)
+{
+	int oldest = 0;
+	for (int recnum = 0; recnum < m_drawn_count; recnum++)
+	{
+		draw_record &record = m_drawn[recnum];
+		if (record.cliprect == blit.cliprect && record.flags == flags && record.priority == blit.tilemap_priority_code)
+		{
+			found = true;
+			return record;
+		}
+		if (record.lastused < m_drawn[oldest].lastused)
+			oldest = recnum;
+	}
+
+	// start a new record, so that later tile updates are collected for it
+	found = false;
+	draw_record &record = m_drawn[(m_drawn_count < MAX_DRAW_RECORDS) ? m_drawn_count++ : oldest];
+	record.cliprect = blit.cliprect;
+	record.flags = flags;
+	record.priority = blit.tilemap_priority_code;
+	record.scroll.resize(0);
+	record.pixmap_dirty.resize(0);
+	return record;
+}
+
+
+//-------------------------------------------------
+//  update_dirty_rects - after a draw, add the
+//  destination areas that may differ from the
+//  previous draw with the same parameters to the
+//  dirty rects
+//-------------------------------------------------
+
+void tilemap_t::update_dirty_rects(screen_device &screen, const blit_parameters &blit, UINT32 flags)
+{
+	rectangle visarea = screen.visible_area();
+	UINT32 width = visarea.min_x + visarea.max_x + 1;
+	UINT32 height = visarea.min_y + visarea.max_y + 1;
+
+	// compare the scroll values to the matching draw's, and remember them for next time
+	bool same;
+	draw_record &record = find_draw_record(blit, flags, same);
+	record.lastused = m_draw_sequence++;
+	if (record.scroll.count() != m_scrollrows + m_scrollcols)
+	{
+		record.scroll.resize(m_scrollrows + m_scrollcols);
+		same = false;
+	}
+	for (int index = 0; index < m_scrollrows; index++)
+	{
+		INT32 value = effective_rowscroll(index, width);
+		same = same && (record.scroll[index] == value);
+		record.scroll[index] = value;
+	}
+	for (int index = 0; index < m_scrollcols; index++)
+	{
+		INT32 value = effective_colscroll(index, height);
+		same = same && (record.scroll[m_scrollrows + index] == value);
+		record.scroll[m_scrollrows + index] = value;
+	}
+
+	// if anything but the pixmap changed, the whole area may have changed
+	if (!same)
+		add_dirty_rect(m_dirty_rects, blit.cliprect);
+
+	// otherwise, map the redrawn parts of the pixmap to each instance drawn; with
+	// row or column scroll, only the unscrolled axis is mapped
+	else
+	{
+		INT32 scrollx = record.scroll[0];
+		INT32 scrolly = record.scroll[m_scrollrows];
+		for (int rectnum = 0; rectnum < record.pixmap_dirty.count(); rectnum++)
+		{
+			const rectangle &pixrect = record.pixmap_dirty[rectnum];
+			for (int ypos = scrolly - m_height; ypos <= blit.cliprect.max_y; ypos += m_height)
+				for (int xpos = scrollx - m_width; xpos <= blit.cliprect.max_x; xpos += m_width)
+				{
+					rectangle rect = pixrect;
+					if (m_scrollrows == 1)
+						rect.offsetx(xpos);
+					else
+						rect.setx(blit.cliprect.min_x, blit.cliprect.max_x);
+					if (m_scrollcols == 1)
+						rect.offsety(ypos);
+					else
+						rect.sety(blit.cliprect.min_y, blit.cliprect.max_y);
+					rect &= blit.cliprect;
+					if (!rect.empty())
+						add_dirty_rect(m_dirty_rects, rect);
+				}
+		}
+	}
+	record.pixmap_dirty.resize(0);
+}
+
+
+//-------------------------------------------------
+//  add_dirty_rect - add a rect to a dirty list,
+//  merging it with the previous one where they
+//  line up and collapsing long lists
+//-------------------------------------------------
+
+void tilemap_t::add_dirty_rect(dynamic_array<rectangle> &rects, const rectangle &rect)
+{
+	// extend the previous rect if this one continues it along the same rows
+	if (rects.count() > 0)
+	{
+		rectangle &last = rects[rects.count() - 1];
+		if (last.min_y == rect.min_y && last.max_y == rect.max_y && last.max_x + 1 >= rect.min_x && rect.max_x + 1 >= last.min_x)
+		{
+			last |= rect;
+			return;
+		}
+	}
+
+	// once the list is full, replace it with its bounds
+	if (rects.count() == MAX_DIRTY_RECTS)
+	{
+		rectangle bounds = rect;
+		for (int rectnum = 0; rectnum < rects.count(); rectnum++)
+			bounds |= rects[rectnum];
+		rects.resize(1);
+		rects[0] = bounds;
+		return;
+	}
+	rects.append(rect);
+}
+
+
 //-------------------------------------------------
 //  draw_roz - draw a tilemap to the destination
 //  with clipping and arbitrary rotate/zoom; pixels
@@ -1074,6 +1324,10 @@ g_profiler.start(PROFILER_TILEMAP_DRAW_ROZ);
 
 	// then do the roz copy
 	draw_roz_core(screen, dest, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+
+	// roz output isn't tracked, so consider it all changed
+	if (m_track_changes)
+		add_dirty_rect(m_dirty_rects, cliprect);
 g_profiler.stop();
 }
 
@@ -1108,6 +1362,19 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 	if (x1 >= x2 || y1 >= y2)
 		return;
 
+	// if we're only preparing for a banded draw, update the tiles under the clip and stop
+	if (blit.tiles_only)
+	{
+		for (int row = (y1 - ypos) / m_tileheight; row <= (y2 - ypos - 1) / m_tileheight; row++)
+			for (int column = (x1 - xpos) / m_tilewidth; column <= (x2 - xpos - 1) / m_tilewidth; column++)
+			{
+				logical_index logindex = row * m_cols + column;
+				if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+					tile_update(logindex, column, row);
+			}
+		return;
+	}
+
 	// look up priority and destination base addresses for y1
 	bitmap_ind8 &priority_bitmap = *blit.priority;
 	UINT8 *priority_baseaddr = &priority_bitmap.pix8(y1, xpos);
@@ -1473,8 +1740,48 @@ void tilemap_t::draw_debug(screen_device &screen, bitmap_rgb32 &dest, UINT32 scr
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_draw_bands(machine.options().tilemap_bands()),
+		m_draw_queue(NULL)
 {
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(tilemap_manager::frame_update), this));
+}
+
+
+//-------------------------------------------------
+//  ~tilemap_manager - destructor
+//-------------------------------------------------
+
+tilemap_manager::~tilemap_manager()
+{
+	if (m_draw_queue != NULL)
+		osd_work_queue_free(m_draw_queue);
+}
+
+
+//-------------------------------------------------
+//  draw_queue - return the queue used to draw
+//  large layers in bands, allocating it the
+//  first time it is needed
+//-------------------------------------------------
+
+osd_work_queue *tilemap_manager::draw_queue()
+{
+	if (m_draw_queue == NULL && m_draw_bands)
+		m_draw_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	return m_draw_queue;
+}
+
+
+//-------------------------------------------------
+//  frame_update - clear the dirty rects of all
+//  tilemaps at the end of each frame
+//-------------------------------------------------
+
+void tilemap_manager::frame_update()
+{
+	for (tilemap_t *tmap = m_tilemap_list.first(); tmap != NULL; tmap = tmap->next())
+		tmap->reset_dirty_rects();
 }
 
 
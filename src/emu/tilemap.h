@@ -528,6 +528,18 @@ public:
 	void mark_tile_dirty(tilemap_memory_index memindex);
 	void mark_all_dirty() { m_all_tiles_dirty = true; m_all_tiles_clean = false; }
 
+	// change tracking, off unless enabled: the destination areas this frame's
+	// draws may have changed compared to the previous draw with the same
+	// cliprect, flags and priority; a driver whose screen is made only of
+	// tilemaps can return UPDATE_HAS_NOT_CHANGED when none of them is dirty,
+	// so the screen texture is not updated again (palette changes are not
+	// tracked, so RGB32 drivers must check those too)
+	void set_track_changes(bool track);
+	const dynamic_array<rectangle> &dirty_rects() const { return m_dirty_rects; }
+	bool dirty() const { return m_dirty_rects.count() != 0; }
+	bool dirty(const rectangle &cliprect) const;
+	void reset_dirty_rects() { m_dirty_rects.resize(0); }
+
 	// pen mapping
 	void map_pens_to_layer(int group, pen_t pen, pen_t mask, UINT8 layermask);
 	void map_pen_to_layer(int group, pen_t pen, UINT8 layermask) { map_pens_to_layer(group, pen, ~0, layermask); }
@@ -578,8 +590,40 @@ private:
 		UINT8               mask;
 		UINT8               value;
 		UINT8               alpha;
+		bool                tiles_only;     // only update the dirty tiles that would be drawn
+	};
+
+	// a horizontal band of a layer, drawn on a worker thread
+	struct draw_band
+	{
+		tilemap_t *         tilemap;
+		screen_device *     screen;
+		void *              dest;
+		blit_parameters     blit;
+	};
+
+	// the last draw made with one set of parameters, for change tracking
+	struct draw_record
+	{
+		rectangle               cliprect;           // cliprect of the draw
+		UINT32                  flags;              // flags of the draw
+		UINT32                  priority;           // priority code of the draw
+		UINT32                  lastused;           // m_draw_sequence when last drawn
+		dynamic_array<INT32>    scroll;             // effective row then column scroll values
+		dynamic_array<rectangle> pixmap_dirty;      // pixmap areas redrawn since the draw
 	};
 
+	// dirty rect lists longer than this are collapsed into their bounds
+	static const int MAX_DIRTY_RECTS = 32;
+
+	// distinct draws tracked per tilemap; beyond this the least recently used is
+	// forgotten and its next draw is reported as a full change
+	static const int MAX_DRAW_RECORDS = 4;
+
+	// minimum pixels per band; a band is cheaper to draw than to hand off below this
+	static const int MIN_BAND_PIXELS = 16384;
+	static const int MAX_DRAW_BANDS = 8;
+
 	// inline helpers
 	INT32 effective_rowscroll(int index, UINT32 screen_width);
 	INT32 effective_colscroll(int index, UINT32 screen_height);
@@ -608,6 +652,11 @@ private:
 	UINT8 tile_apply_bitmask(const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
+	template<class _BitmapClass> void draw_layer(screen_device &screen, _BitmapClass &dest, blit_parameters &blit);
+	template<class _BitmapClass> static void *draw_band_callback(void *param, int threadid);
+	void update_dirty_rects(screen_device &screen, const blit_parameters &blit, UINT32 flags);
+	draw_record &find_draw_record(const blit_parameters &blit, UINT32 flags, bool &found);
+	static void add_dirty_rect(dynamic_array<rectangle> &rects, const rectangle &rect);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
@@ -668,6 +717,13 @@ private:
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	UINT8 *                     m_tileflags;            // per-tile flags
 	UINT8                       m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
+
+	// change tracking
+	bool                        m_track_changes;        // true if change tracking is enabled
+	dynamic_array<rectangle>    m_dirty_rects;          // destination areas changed by draws this frame
+	draw_record                 m_drawn[MAX_DRAW_RECORDS]; // the most recent distinct draws
+	int                         m_drawn_count;          // number of valid entries in m_drawn
+	UINT32                      m_draw_sequence;        // count of tracked draws, for picking the oldest record
 };
 
 
@@ -681,6 +737,7 @@ class tilemap_manager
 public:
 	// construction/destuction
 	tilemap_manager(running_machine &machine);
+	~tilemap_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -701,10 +758,18 @@ private:
 	// allocate an instance index
 	int alloc_instance() { return ++m_instance; }
 
+	// get the queue for drawing bands, allocating it on first use; NULL if banding is off
+	osd_work_queue *draw_queue();
+
+	// start a new frame of change tracking
+	void frame_update();
+
 	// internal state
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	bool                    m_draw_bands;
+	osd_work_queue *        m_draw_queue;
 };
 
 
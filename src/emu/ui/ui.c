@@ -1565,6 +1565,10 @@ UINT32 ui_manager::handler_ingame(running_machine &machine, render_container *co
 		return machine.ui().set_handler(handler_load_save, LOADSAVE_LOAD);
 	}
 
+	// handle a rewind request
+	if (ui_input_pressed(machine, IPT_UI_REWIND_SINGLE))
+		machine.schedule_rewind();
+
 	// handle a save snapshot request 
 	if (ui_input_pressed(machine, IPT_UI_SNAPSHOT))
 		machine.video().save_active_screen_snapshots();
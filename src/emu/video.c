@@ -15,6 +15,7 @@
 #include "debugint/debugint.h"
 #include "ui/ui.h"
 #include "aviio.h"
+#include "mfvio.h"
 #include "crsshair.h"
 #include "rendersw.c"
 #include "output.h"
@@ -31,6 +32,19 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// audio rate control: the most the speed is nudged either way, the fill we aim
+// for as a fraction of the OSD's latency, and the per-frame filter weights
+const double RATE_CONTROL_MAX_DEVIATION = 0.005;
+const double RATE_CONTROL_SETPOINT = 0.75;
+const double RATE_CONTROL_SMOOTHING = 1.0 / 32;
+const double RATE_CONTROL_INTEGRAL_GAIN = 0.002;
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -97,15 +111,30 @@ video_manager::video_manager(running_machine &machine)
 		m_frameskip_adjust(0),
 		m_skipping_this_frame(false),
 		m_average_oversleep(0),
+		m_rate_control(machine.options().audio_rate_control()),
+		m_rate_control_factor(1.0f),
+		m_rate_control_fill(-1.0),
+		m_rate_control_integral(0.0),
 		m_snap_target(NULL),
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
 		m_mngfile(NULL),
 		m_avifile(NULL),
+		m_mfvfile(NULL),
+		m_mfv(NULL),
 		m_movie_frame_period(attotime::zero),
 		m_movie_next_frame_time(attotime::zero),
-		m_movie_frame(0)
+		m_movie_frame(0),
+		m_png_queue(NULL),
+		m_encode_queue(NULL),
+		m_encode_drop(machine.options().record_drop()),
+		m_encode_submitted(0),
+		m_encode_completed(0),
+		m_encode_reported(0),
+		m_encode_error(0),
+		m_encode_dropped(0),
+		m_encode_dropped_total(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -143,6 +172,23 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// let large snapshots and MNG frames compress on all processors; only the
+	// thread that encodes them uses this queue, as it has a single waiter
+	m_png_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	// set up the encoder thread for snapshots and movies
+	int jobs = machine.options().record_queue();
+	if (jobs > 0)
+	{
+		m_encode_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		if (m_encode_queue != NULL)
+		{
+			m_encode_jobs.resize(jobs);
+			for (int jobnum = 0; jobnum < jobs; jobnum++)
+				m_encode_jobs[jobnum].m_manager = this;
+		}
+	}
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -152,6 +198,10 @@ video_manager::video_manager(running_machine &machine)
 	if (filename[0] != 0)
 		begin_recording(filename, MF_AVI);
 
+	filename = machine.options().mfv_write();
+	if (filename[0] != 0)
+		begin_recording(filename, MF_MFV);
+
 	// if no screens, create a periodic timer to drive updates
 	if (machine.primary_screen == NULL)
 	{
@@ -229,6 +279,10 @@ void video_manager::frame_update(bool debug)
 	if (!debug)
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
 
+	// report any snapshots the encoder failed to write
+	if (m_encode_queue != NULL)
+		encode_report();
+
 	// update frameskipping
 	if (!debug)
 		update_frameskip();
@@ -285,6 +339,15 @@ astring &video_manager::speed_text(astring &string)
 	if (partials > 1)
 		string.catprintf("\n%d partial updates", partials);
 
+	// display the audio buffering if the OSD layer reports it
+	osd_audio_stats audio;
+	if (machine().osd().get_audio_stats(audio) && machine().sample_rate() != 0)
+	{
+		string.catprintf("\nsound %d/%dms", audio.buffered * 1000 / machine().sample_rate(), audio.latency * 1000 / machine().sample_rate());
+		if (audio.underflows != 0 || audio.overflows != 0)
+			string.catprintf(" (%d under, %d over)", audio.underflows, audio.overflows);
+	}
+
 	return string;
 }
 
@@ -302,22 +365,12 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	// create the bitmap to pass in
 	create_snapshot_bitmap(screen);
 
-	// add two text entries describing the image
-	astring text1(emulator_info::get_appname(), " ", build_version);
-	astring text2(machine().system().manufacturer, " ", machine().system().description);
-	png_info pnginfo = { 0 };
-	png_add_text(&pnginfo, "Software", text1);
-	png_add_text(&pnginfo, "System", text2);
-
 	// now do the actual work
 	const rgb_t *palette = (screen !=NULL && screen->palette() != NULL) ? screen->palette()->palette()->entry_list_adjusted() : NULL;
 	int entries = (screen !=NULL && screen->palette() != NULL) ? screen->palette()->entries() : 0;
-	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette);
+	int error = write_snapshot(m_snap_bitmap, file, entries, palette, NULL);
 	if (error != PNGERR_NONE)
 		mame_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
-
-	// free any data allocated
-	png_free(&pnginfo);
 }
 
 
@@ -335,22 +388,53 @@ void video_manager::save_active_screen_snapshots()
 		screen_device_iterator iter(machine().root_device());
 		for (screen_device *screen = iter.first(); screen != NULL; screen = iter.next())
 			if (machine().render().is_live(*screen))
-			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				file_error filerr = open_next(file, "png");
-				if (filerr == FILERR_NONE)
-					save_snapshot(screen, file);
-			}
+				save_next_snapshot(screen);
 	}
 
 	// otherwise, just write a single snapshot
 	else
+		save_next_snapshot(NULL);
+}
+
+
+//-------------------------------------------------
+//  save_next_snapshot - save a snapshot to the
+//  next free file name, on the encoder thread if
+//  there is one
+//-------------------------------------------------
+
+void video_manager::save_next_snapshot(screen_device *screen)
+{
+	// without an encoder, write it right here
+	if (m_encode_queue == NULL)
 	{
 		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 		file_error filerr = open_next(file, "png");
 		if (filerr == FILERR_NONE)
-			save_snapshot(NULL, file);
+			save_snapshot(screen, file);
+		return;
 	}
+
+	// otherwise, claim the file name now so that back-to-back snapshots get distinct ones
+	emu_file *file = global_alloc(emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS));
+	file_error filerr = open_next(*file, "png");
+	if (filerr != FILERR_NONE)
+	{
+		global_free(file);
+		return;
+	}
+
+	// snapshots are never dropped; the snapshot bitmap is always RGB32, so no palette is needed
+	create_snapshot_bitmap(screen);
+	encode_job *job = encode_alloc(false);
+	job->m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+	copybitmap(job->m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+	job->m_sound.resize(0);
+	job->m_file = file;
+	job->m_repeat = 0;
+	job->m_first = false;
+	job->m_error = PNGERR_NONE;
+	encode_submit(*job);
 }
 
 
@@ -447,6 +531,49 @@ void video_manager::begin_recording(const char *name, movie_format format)
 			m_mngfile = NULL;
 		}
 	}
+
+	// start up a lossless recording
+	else if (format == MF_MFV)
+	{
+		// build up information about this new movie
+		mfv_movie_info info;
+		info.video_timescale = 1000 * ((machine().primary_screen != NULL) ? ATTOSECONDS_TO_HZ(machine().primary_screen->frame_period().attoseconds) : screen_device::DEFAULT_FRAME_RATE);
+		info.video_sampletime = 1000;
+		info.video_numframes = 0;
+		info.video_width = m_snap_bitmap.width();
+		info.video_height = m_snap_bitmap.height();
+		info.audio_samplerate = machine().sample_rate();
+		info.audio_channels = 2;
+		info.audio_numsamples = 0;
+
+		// create a new movie file and start recording
+		m_mfvfile = auto_alloc(machine(), emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS));
+		file_error filerr;
+		if (name != NULL)
+			filerr = m_mfvfile->open(name);
+		else
+			filerr = open_next(*m_mfvfile, "mfv");
+
+		if (filerr == FILERR_NONE)
+		{
+			// write the header
+			mfv_error mfverr = mfv_create(*m_mfvfile, &info, &m_mfv);
+			if (mfverr != MFVERR_NONE)
+			{
+				mame_printf_error("Error creating MFV: %s\n", mfv_error_string(mfverr));
+				return end_recording();
+			}
+
+			// compute the frame time
+			m_movie_frame_period = attotime::from_seconds(1000) / info.video_timescale;
+		}
+		else
+		{
+			mame_printf_error("Error creating MFV\n");
+			auto_free(machine(), m_mfvfile);
+			m_mfvfile = NULL;
+		}
+	}
 }
 
 
@@ -456,6 +583,23 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording()
 {
+	// let the encoder finish the queued frames, then write any leftover sound and
+	// make up for frames dropped at the very end with the last one rendered
+	if (m_encode_queue != NULL)
+	{
+		encode_wait();
+		if (m_encode_sound.count() > 0 && m_encode_error == 0)
+			write_movie_sound(&m_encode_sound[0], m_encode_sound.count() / 2);
+		for (UINT32 frame = 0; frame < m_encode_dropped && m_encode_error == 0; frame++)
+			if (!write_movie_frame(m_snap_bitmap, false))
+				m_encode_error = 1;
+		if (m_encode_dropped_total != 0)
+			mame_printf_verbose("Movie recording dropped %d frames\n", m_encode_dropped_total);
+		m_encode_sound.resize(0);
+		m_encode_error = 0;
+		m_encode_dropped = m_encode_dropped_total = 0;
+	}
+
 	// close the file if it exists
 	if (m_avifile != NULL)
 	{
@@ -471,6 +615,16 @@ void video_manager::end_recording()
 		m_mngfile = NULL;
 	}
 
+	// close the file if it exists
+	if (m_mfvfile != NULL)
+	{
+		if (m_mfv != NULL)
+			mfv_close(m_mfv);
+		m_mfv = NULL;
+		auto_free(machine(), m_mfvfile);
+		m_mfvfile = NULL;
+	}
+
 	// reset the state
 	m_movie_frame = 0;
 }
@@ -483,16 +637,22 @@ void video_manager::end_recording()
 
 void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 {
-	// only record if we have a file
-	if (m_avifile != NULL)
+	// only record if we have a file that takes sound
+	if (m_avifile != NULL || m_mfv != NULL)
 	{
+		// with an encoder, hold on to the sound until the next frame is queued
+		if (m_encode_queue != NULL)
+		{
+			int count = m_encode_sound.count();
+			m_encode_sound.resize_keep(count + numsamples * 2);
+			memcpy(&m_encode_sound[count], sound, numsamples * 2 * sizeof(*sound));
+			return;
+		}
+
 		g_profiler.start(PROFILER_MOVIE_REC);
 
 		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avifile, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avifile, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
+		if (!write_movie_sound(sound, numsamples))
 			end_recording();
 
 		g_profiler.stop();
@@ -510,18 +670,44 @@ void video_manager::exit()
 	// stop recording any movie
 	end_recording();
 
+	// finish any snapshots still being written
+	if (m_encode_queue != NULL)
+	{
+		encode_wait();
+		osd_work_queue_free(m_encode_queue);
+		m_encode_queue = NULL;
+	}
+	if (m_png_queue != NULL)
+	{
+		osd_work_queue_free(m_png_queue);
+		m_png_queue = NULL;
+	}
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (m_overall_emutime.seconds >= 1)
-	{
-		osd_ticks_t tps = osd_ticks_per_second();
-		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
-		double final_emu_time = m_overall_emutime.as_double();
-		mame_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds);
-	}
+		mame_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * average_speed(), (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds);
+}
+
+
+//-------------------------------------------------
+//  average_speed - return the ratio of emulated
+//  to real time accumulated by recompute_speed,
+//  or 0 if there is not enough data yet
+//-------------------------------------------------
+
+double video_manager::average_speed() const
+{
+	if (m_overall_emutime.seconds < 1)
+		return 0;
+
+	osd_ticks_t tps = osd_ticks_per_second();
+	double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
+	double final_emu_time = m_overall_emutime.as_double();
+	return final_emu_time / final_real_time;
 }
 
 
@@ -716,7 +902,7 @@ void video_manager::update_throttle(attotime emutime)
 
 		// compute conversion factors up front
 		osd_ticks_t ticks_per_second = osd_ticks_per_second();
-		attoseconds_t attoseconds_per_tick = ATTOSECONDS_PER_SECOND / ticks_per_second * m_throttle_rate;
+		attoseconds_t attoseconds_per_tick = ATTOSECONDS_PER_SECOND / ticks_per_second * (m_throttle_rate * m_rate_control_factor);
 
 		// if we're paused, emutime will not advance; instead, we subtract a fixed
 		// amount of time (1/60th of a second) from the emulated time that was passed in,
@@ -870,8 +1056,8 @@ void video_manager::update_frameskip()
 	// if we're throttling and autoframeskip is on, adjust
 	if (effective_throttle() && effective_autoframeskip() && m_frameskip_counter == 0)
 	{
-		// calibrate the "adjusted speed" based on the target
-		double adjusted_speed_percent = m_speed_percent / m_throttle_rate;
+		// calibrate the "adjusted speed" based on the target, including any nudge from the sound buffer
+		double adjusted_speed_percent = m_speed_percent / (m_throttle_rate * m_rate_control_factor);
 
 		// if we're too fast, attempt to increase the frameskip
 		double speed = m_speed * 0.001;
@@ -963,6 +1149,10 @@ void video_manager::update_refresh_speed()
 
 void video_manager::recompute_speed(attotime emutime)
 {
+	// let the sound buffer steer the throttle
+	if (m_rate_control)
+		update_rate_control();
+
 	// if we don't have a starting time yet, or if we're paused, reset our starting point
 	if (m_speed_last_realtime == 0 || machine().paused())
 	{
@@ -1021,6 +1211,44 @@ void video_manager::recompute_speed(attotime emutime)
 }
 
 
+//-------------------------------------------------
+//  update_rate_control - nudge the throttle rate
+//  by a fraction of a percent so that the OSD's
+//  sound buffer stays at a steady fill level,
+//  absorbing the drift between the host's clock
+//  and the sound hardware's
+//-------------------------------------------------
+
+void video_manager::update_rate_control()
+{
+	// only steer while throttling normally and the OSD can tell us about its buffer
+	osd_audio_stats audio;
+	if (!effective_throttle() || machine().paused() || !machine().osd().get_audio_stats(audio) || audio.latency <= 0)
+	{
+		// the integral tracks the clock drift, so keep it for when we resume
+		m_rate_control_factor = 1.0f;
+		m_rate_control_fill = -1.0;
+		return;
+	}
+
+	// the fill is sampled at an arbitrary point between sound updates and OSD
+	// transfers, so average it over a few dozen frames
+	if (m_rate_control_fill < 0)
+		m_rate_control_fill = audio.buffered;
+	else
+		m_rate_control_fill += (audio.buffered - m_rate_control_fill) * RATE_CONTROL_SMOOTHING;
+
+	// proportional-integral control; the integral cancels a steady drift without
+	// leaving the buffer parked away from the setpoint
+	double error = (m_rate_control_fill - audio.latency * RATE_CONTROL_SETPOINT) / audio.latency;
+	m_rate_control_integral = MIN(MAX(m_rate_control_integral + error * RATE_CONTROL_INTEGRAL_GAIN, -1.0), 1.0);
+	double adjust = MIN(MAX(error + m_rate_control_integral, -1.0), 1.0);
+
+	// an overfull buffer means we are running fast, so slow down, and vice versa
+	m_rate_control_factor = 1.0 - adjust * RATE_CONTROL_MAX_DEVIATION;
+}
+
+
 //-------------------------------------------------
 //  create_snapshot_bitmap - creates a
 //  bitmap containing the screenshot for the
@@ -1192,9 +1420,13 @@ file_error video_manager::open_next(emu_file &file, const char *extension)
 void video_manager::record_frame()
 {
 	// ignore if nothing to do
-	if (m_mngfile == NULL && m_avifile == NULL)
+	if (!is_recording())
 		return;
 
+	// stop if the encoder ran into trouble
+	if (m_encode_error != 0)
+		return end_recording();
+
 	// start the profiler and get the current time
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
@@ -1202,44 +1434,54 @@ void video_manager::record_frame()
 	// create the bitmap
 	create_snapshot_bitmap(NULL);
 
-	// loop until we hit the right time
-	while (m_movie_next_frame_time <= curtime)
+	// with an encoder, hand it a copy covering every frame that is due
+	if (m_encode_queue != NULL)
 	{
-		// handle an AVI recording
-		if (m_avifile != NULL)
+		bool first = (m_movie_frame == 0);
+		UINT32 frames = 0;
+		for ( ; m_movie_next_frame_time <= curtime; frames++)
 		{
-			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avifile, m_snap_bitmap);
-			if (avierr != AVIERR_NONE)
-			{
-				g_profiler.stop();
-				return end_recording();
-			}
+			m_movie_next_frame_time += m_movie_frame_period;
+			m_movie_frame++;
 		}
 
-		// handle a MNG recording
-		if (m_mngfile != NULL)
+		if (frames != 0)
 		{
-			// set up the text fields in the movie info
-			png_info pnginfo = { 0 };
-			if (m_movie_frame == 0)
+			// a dropped frame is made up by repeating the next one, which keeps sound in sync
+			encode_job *job = encode_alloc(m_encode_drop && !first);
+			if (job == NULL)
 			{
-				astring text1(emulator_info::get_appname(), " ", build_version);
-				astring text2(machine().system().manufacturer, " ", machine().system().description);
-				png_add_text(&pnginfo, "Software", text1);
-				png_add_text(&pnginfo, "System", text2);
+				m_encode_dropped += frames;
+				m_encode_dropped_total += frames;
 			}
-
-			// write the next frame
-			const rgb_t *palette = (machine().primary_screen->palette() != NULL) ? machine().primary_screen->palette()->palette()->entry_list_adjusted() : NULL;
-			png_error error = mng_capture_frame(*m_mngfile, &pnginfo, m_snap_bitmap, machine().primary_screen->palette()->entries(), palette);
-			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
+			else
 			{
-				g_profiler.stop();
-				return end_recording();
+				job->m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+				copybitmap(job->m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+				job->m_sound.resize(m_encode_sound.count());
+				if (m_encode_sound.count() > 0)
+					memcpy(&job->m_sound[0], &m_encode_sound[0], m_encode_sound.count() * sizeof(m_encode_sound[0]));
+				m_encode_sound.resize(0);
+				job->m_file = NULL;
+				job->m_repeat = frames + m_encode_dropped;
+				job->m_first = first;
+				m_encode_dropped = 0;
+				encode_submit(*job);
 			}
 		}
+		g_profiler.stop();
+		return;
+	}
+
+	// loop until we hit the right time
+	while (m_movie_next_frame_time <= curtime)
+	{
+		// write the next frame
+		if (!write_movie_frame(m_snap_bitmap, m_movie_frame == 0))
+		{
+			g_profiler.stop();
+			return end_recording();
+		}
 
 		// advance time
 		m_movie_next_frame_time += m_movie_frame_period;
@@ -1248,6 +1490,206 @@ void video_manager::record_frame()
 	g_profiler.stop();
 }
 
+
+//-------------------------------------------------
+//  write_snapshot - write a bitmap to a file as
+//  a PNG, returning the png_error; this may run
+//  on the encoder thread, so it doesn't report it
+//-------------------------------------------------
+
+int video_manager::write_snapshot(bitmap_rgb32 &bitmap, emu_file &file, int entries, const rgb_t *palette, osd_work_queue *queue)
+{
+	// add two text entries describing the image
+	astring text1(emulator_info::get_appname(), " ", build_version);
+	astring text2(machine().system().manufacturer, " ", machine().system().description);
+	png_info pnginfo = { 0 };
+	png_add_text(&pnginfo, "Software", text1);
+	png_add_text(&pnginfo, "System", text2);
+
+	// now do the actual work
+	png_error error = png_write_bitmap(file, &pnginfo, bitmap, entries, palette, queue);
+
+	// free any data allocated
+	png_free(&pnginfo);
+	return error;
+}
+
+
+//-------------------------------------------------
+//  write_movie_frame - append a frame to the open
+//  movie files; returns false on error
+//-------------------------------------------------
+
+bool video_manager::write_movie_frame(bitmap_rgb32 &bitmap, bool first)
+{
+	// handle an AVI recording
+	if (m_avifile != NULL)
+	{
+		// write the next frame
+		avi_error avierr = avi_append_video_frame(m_avifile, bitmap);
+		if (avierr != AVIERR_NONE)
+			return false;
+	}
+
+	// handle a MNG recording
+	if (m_mngfile != NULL)
+	{
+		// set up the text fields in the movie info
+		png_info pnginfo = { 0 };
+		if (first)
+		{
+			astring text1(emulator_info::get_appname(), " ", build_version);
+			astring text2(machine().system().manufacturer, " ", machine().system().description);
+			png_add_text(&pnginfo, "Software", text1);
+			png_add_text(&pnginfo, "System", text2);
+		}
+
+		// write the next frame; the bitmap is RGB32, so the palette is not used
+		png_error error = mng_capture_frame(*m_mngfile, &pnginfo, bitmap, 0, NULL, m_png_queue);
+		png_free(&pnginfo);
+		if (error != PNGERR_NONE)
+			return false;
+	}
+
+	// handle a lossless recording
+	if (m_mfv != NULL)
+	{
+		mfv_error mfverr = mfv_append_video_frame(m_mfv, bitmap);
+		if (mfverr != MFVERR_NONE)
+			return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  write_movie_sound - append interleaved stereo
+//  sound to the open movie files; returns false
+//  on error
+//-------------------------------------------------
+
+bool video_manager::write_movie_sound(const INT16 *sound, int numsamples)
+{
+	// handle an AVI recording
+	if (m_avifile != NULL)
+	{
+		avi_error avierr = avi_append_sound_samples(m_avifile, 0, sound + 0, numsamples, 1);
+		if (avierr == AVIERR_NONE)
+			avierr = avi_append_sound_samples(m_avifile, 1, sound + 1, numsamples, 1);
+		if (avierr != AVIERR_NONE)
+			return false;
+	}
+
+	// handle a lossless recording
+	if (m_mfv != NULL)
+	{
+		mfv_error mfverr = mfv_append_sound_samples(m_mfv, sound, numsamples);
+		if (mfverr != MFVERR_NONE)
+			return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  encode_alloc - return the next free job in
+//  the ring, waiting for one unless dropping is
+//  allowed, in which case NULL means it is full
+//-------------------------------------------------
+
+video_manager::encode_job *video_manager::encode_alloc(bool drop)
+{
+	UINT32 jobs = m_encode_jobs.count();
+	while (m_encode_submitted - UINT32(m_encode_completed) >= jobs)
+	{
+		if (drop)
+			return NULL;
+		osd_work_queue_wait(m_encode_queue, osd_ticks_per_second() / 100);
+	}
+	encode_report();
+	return &m_encode_jobs[m_encode_submitted % jobs];
+}
+
+
+//-------------------------------------------------
+//  encode_submit - hand a filled-in job to the
+//  encoder thread
+//-------------------------------------------------
+
+void video_manager::encode_submit(encode_job &job)
+{
+	m_encode_submitted++;
+	osd_work_item_queue(m_encode_queue, encode_callback, &job, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  encode_wait - wait for the encoder to finish
+//  every job submitted so far
+//-------------------------------------------------
+
+void video_manager::encode_wait()
+{
+	while (m_encode_submitted != UINT32(m_encode_completed))
+		osd_work_queue_wait(m_encode_queue, osd_ticks_per_second() / 10);
+	encode_report();
+}
+
+
+//-------------------------------------------------
+//  encode_report - report errors from snapshots
+//  the encoder has finished since the last call
+//-------------------------------------------------
+
+void video_manager::encode_report()
+{
+	UINT32 jobs = m_encode_jobs.count();
+	for ( ; m_encode_reported != UINT32(m_encode_completed); m_encode_reported++)
+	{
+		encode_job &job = m_encode_jobs[m_encode_reported % jobs];
+		if (job.m_error != PNGERR_NONE)
+			mame_printf_error("Error generating PNG for snapshot: png_error = %d\n", job.m_error);
+		job.m_error = PNGERR_NONE;
+	}
+}
+
+
+//-------------------------------------------------
+//  encode_callback - work queue entry point for
+//  the encoder thread
+//-------------------------------------------------
+
+void *video_manager::encode_callback(void *param, int threadid)
+{
+	encode_job &job = *reinterpret_cast<encode_job *>(param);
+	video_manager &manager = *job.m_manager;
+
+	// snapshots own their file
+	if (job.m_file != NULL)
+	{
+		job.m_error = manager.write_snapshot(job.m_bitmap, *job.m_file, 0, NULL, manager.m_png_queue);
+		global_free(job.m_file);
+		job.m_file = NULL;
+	}
+
+	// movie frames go out once per frame period covered, after their sound; once
+	// something fails, the rest are skipped until the recording is ended
+	else if (manager.m_encode_error == 0)
+	{
+		bool success = true;
+		if (job.m_sound.count() > 0)
+			success = manager.write_movie_sound(&job.m_sound[0], job.m_sound.count() / 2);
+		for (UINT32 frame = 0; success && frame < job.m_repeat; frame++)
+			success = manager.write_movie_frame(job.m_bitmap, job.m_first && frame == 0);
+		if (!success)
+			atomic_exchange32(&manager.m_encode_error, 1);
+	}
+
+	// hand the job back to the emulation thread
+	atomic_increment32(&manager.m_encode_completed);
+	return NULL;
+}
+
 //-------------------------------------------------
 //	toggle_throttle
 //-------------------------------------------------
@@ -36,6 +36,7 @@ const int MAX_FRAMESKIP = FRAMESKIP_LEVELS - 2;
 class render_target;
 class screen_device;
 struct avi_file;
+struct mfv_file;
 
 
 
@@ -50,7 +51,8 @@ public:
 	enum movie_format
 	{
 		MF_MNG,
-		MF_AVI
+		MF_AVI,
+		MF_MFV
 	};
 
 	// construction/destruction
@@ -64,7 +66,7 @@ public:
 	bool throttled() const { return m_throttled; }
 	float throttle_rate() const { return m_throttle_rate; }
 	bool fastforward() const { return m_fastforward; }
-	bool is_recording() const { return (m_mngfile != NULL || m_avifile != NULL); }
+	bool is_recording() const { return (m_mngfile != NULL || m_avifile != NULL || m_mfv != NULL); }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -83,6 +85,7 @@ public:
 	// current speed helpers
 	astring &speed_text(astring &string);
 	double speed_percent() const { return m_speed_percent; }
+	double average_speed() const;
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
@@ -112,11 +115,37 @@ private:
 	void update_frameskip();
 	void update_refresh_speed();
 	void recompute_speed(attotime emutime);
+	void update_rate_control();
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
 	file_error open_next(emu_file &file, const char *extension);
+	void save_next_snapshot(screen_device *screen);
 	void record_frame();
+	int write_snapshot(bitmap_rgb32 &bitmap, emu_file &file, int entries, const rgb_t *palette, osd_work_queue *queue);
+	bool write_movie_frame(bitmap_rgb32 &bitmap, bool first);
+	bool write_movie_sound(const INT16 *sound, int numsamples);
+
+	// a single snapshot or movie frame handed to the encoder thread
+	struct encode_job
+	{
+		encode_job() : m_manager(NULL), m_file(NULL), m_repeat(0), m_first(false), m_error(0) { }
+
+		video_manager *     m_manager;              // back-pointer for the work callback
+		bitmap_rgb32        m_bitmap;               // copy of the snapshot bitmap
+		dynamic_array<INT16> m_sound;               // interleaved stereo sound to append before the frame
+		emu_file *          m_file;                 // destination of a PNG snapshot, or NULL for a movie frame
+		UINT32              m_repeat;               // number of movie frames this bitmap covers
+		bool                m_first;                // true for the first frame of a MNG
+		int                 m_error;                // png_error of a snapshot, reported by the emulation thread
+	};
+
+	// asynchronous encoding helpers
+	encode_job *encode_alloc(bool drop);
+	void encode_submit(encode_job &job);
+	void encode_wait();
+	void encode_report();
+	static void *encode_callback(void *param, int threadid);
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -158,6 +187,12 @@ private:
 	bool                m_skipping_this_frame;      // flag: TRUE if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// audio rate control
+	bool                m_rate_control;             // flag: TRUE if the sound buffer steers the speed
+	float               m_rate_control_factor;      // adjustment currently applied to the throttle rate
+	double              m_rate_control_fill;        // smoothed sound buffer fill, or negative if unknown
+	double              m_rate_control_integral;    // accumulated fill error
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
@@ -168,10 +203,25 @@ private:
 	// movie recording
 	emu_file *          m_mngfile;                  // handle to the open movie file
 	avi_file *          m_avifile;                  // handle to the open movie file
+	emu_file *          m_mfvfile;                  // handle to the open movie file
+	mfv_file *          m_mfv;                      // lossless movie writer on m_mfvfile
 	attotime            m_movie_frame_period;       // period of a single movie frame
 	attotime            m_movie_next_frame_time;    // time of next frame
 	UINT32              m_movie_frame;              // current movie frame number
 
+	// asynchronous encoding
+	osd_work_queue *    m_png_queue;                // queue the encoding thread splits PNG compression across
+	osd_work_queue *    m_encode_queue;             // queue for the encoder thread, or NULL to encode inline
+	dynamic_array<encode_job> m_encode_jobs;        // ring of jobs handed to the encoder
+	bool                m_encode_drop;              // drop movie frames rather than wait when the ring is full
+	UINT32              m_encode_submitted;         // number of jobs submitted
+	volatile INT32      m_encode_completed;         // number of jobs finished by the encoder
+	UINT32              m_encode_reported;          // number of finished jobs checked for snapshot errors
+	volatile INT32      m_encode_error;             // set by the encoder if a movie frame failed
+	UINT32              m_encode_dropped;           // movie frames dropped since the last submitted one
+	UINT32              m_encode_dropped_total;     // movie frames dropped in this recording
+	dynamic_array<INT16> m_encode_sound;            // movie sound waiting for the next frame
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
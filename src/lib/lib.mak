@@ -50,6 +50,7 @@ UTILOBJS = \
 	$(LIBOBJ)/util/huffman.o \
 	$(LIBOBJ)/util/jedparse.o \
 	$(LIBOBJ)/util/md5.o \
+	$(LIBOBJ)/util/mfvio.o \
 	$(LIBOBJ)/util/opresolv.o \
 	$(LIBOBJ)/util/options.o \
 	$(LIBOBJ)/util/palette.o \
@@ -99,5 +99,115 @@ private:
 typedef dynamic_array<UINT8> dynamic_buffer;
 
 
+// ======================> indexed_heap
+
+// a binary min-heap of element pointers; each element tracks its own
+// position in an int m_heap_index member (-1 while not in the heap) so it
+// can be moved or removed in O(log n), and orders itself against another
+// element with a bool heap_before(const _ElementType &) const member
+template<class _ElementType>
+class indexed_heap
+{
+private:
+	// we don't support deep copying
+	indexed_heap(const indexed_heap &);
+	indexed_heap &operator=(const indexed_heap &);
+
+public:
+	// construction/destruction
+	indexed_heap() { }
+
+	// simple getters
+	int count() const { return m_heap.count(); }
+	_ElementType &head() const { assert(m_heap.count() > 0); return *m_heap[0]; }
+	static bool contains(const _ElementType &element) { return (element.m_heap_index >= 0); }
+
+	// core operations
+	void update(_ElementType &element)
+	{
+		// new entries go at the end and bubble up; existing ones may move either way
+		if (element.m_heap_index < 0)
+		{
+			element.m_heap_index = m_heap.count();
+			m_heap.append(&element);
+			sift_up(element.m_heap_index);
+		}
+		else
+			sift_down(sift_up(element.m_heap_index));
+	}
+
+	void remove(_ElementType &element)
+	{
+		assert(element.m_heap_index >= 0 && element.m_heap_index < m_heap.count());
+		assert(m_heap[element.m_heap_index] == &element);
+
+		// fill the hole with the last entry, then fix up its position
+		int index = element.m_heap_index;
+		int last = m_heap.count() - 1;
+		_ElementType *filler = m_heap[last];
+		m_heap.resize_keep(last);
+		element.m_heap_index = -1;
+		if (index != last)
+		{
+			m_heap[index] = filler;
+			filler->m_heap_index = index;
+			sift_down(sift_up(index));
+		}
+	}
+
+	// bulk rebuilding: reset(), append() each entry in any order, then reorder();
+	// reset() does not touch the entries, so the caller must clear their indexes
+	void reset() { m_heap.resize(0); }
+	void append(_ElementType &element) { element.m_heap_index = m_heap.count(); m_heap.append(&element); }
+	void reorder() { for (int index = m_heap.count() / 2 - 1; index >= 0; index--) sift_down(index); }
+
+private:
+	// move the entry at the given index towards the head until it is in order
+	int sift_up(int index)
+	{
+		_ElementType *element = m_heap[index];
+		while (index > 0)
+		{
+			int parentindex = (index - 1) / 2;
+			_ElementType *parent = m_heap[parentindex];
+			if (!element->heap_before(*parent))
+				break;
+			m_heap[index] = parent;
+			parent->m_heap_index = index;
+			index = parentindex;
+		}
+		m_heap[index] = element;
+		element->m_heap_index = index;
+		return index;
+	}
+
+	// move the entry at the given index towards the tail until it is in order
+	int sift_down(int index)
+	{
+		_ElementType *element = m_heap[index];
+		int count = m_heap.count();
+		while (true)
+		{
+			int childindex = 2 * index + 1;
+			if (childindex >= count)
+				break;
+			if (childindex + 1 < count && m_heap[childindex + 1]->heap_before(*m_heap[childindex]))
+				childindex++;
+			if (!m_heap[childindex]->heap_before(*element))
+				break;
+			m_heap[index] = m_heap[childindex];
+			m_heap[index]->m_heap_index = index;
+			index = childindex;
+		}
+		m_heap[index] = element;
+		element->m_heap_index = index;
+		return index;
+	}
+
+	// internal state
+	dynamic_array<_ElementType *> m_heap;   // heap-ordered element pointers
+};
+
+
 
 #endif
@@ -0,0 +1,730 @@
+/***************************************************************************
+
+    mfvio.c
+
+    Fast lossless inter-frame movie format for emulated video.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    Most of an emulated screen is unchanged from one frame to the next,
+    so each frame is stored as the difference against the previous one:
+    rows that did not change are skipped entirely, and the changed span
+    of each remaining row is XORed against the previous frame, which
+    leaves long runs of zeroes for the entropy coder. The result is
+    deflated at the fastest level, which is where nearly all of the
+    encoding time goes. Every so often a keyframe is encoded against an
+    all-black frame so that a damaged file can be resynchronized.
+
+    All values are little-endian.
+
+    File header (48 bytes):
+         0  8  magic "MAMEMFV\x1a"
+         8  4  version
+        12  4  video width
+        16  4  video height
+        20  4  video timescale
+        24  4  video sample time
+        28  4  number of video frames (written on close)
+        32  4  audio sample rate, or 0 for no audio
+        36  4  audio channels
+        40  4  number of audio samples per channel (written on close)
+        44  4  reserved
+
+    Followed by chunks, each with a 12-byte header:
+         0  1  type ('V' for video, 'A' for audio)
+         1  1  flags
+         2  2  reserved
+         4  4  length of the payload
+         8  4  video: length of the residual once inflated
+               audio: number of samples per channel
+
+    Video payload (raw deflate of the residual):
+        (height + 7) / 8 bytes of bitmask, one bit per row, LSB first,
+        set if the row is present; then for each present row:
+            2  first changed pixel
+            2  number of pixels
+            n  R,G,B bytes for each pixel, XORed with the previous frame
+
+    A video chunk flagged MFV_FLAG_REPEAT has no payload and repeats
+    the previous frame; one flagged MFV_FLAG_KEYFRAME is XORed against
+    an all-black frame instead of the previous one.
+
+    Audio payload: interleaved signed 16-bit samples.
+
+***************************************************************************/
+
+#include <stdlib.h>
+#include <zlib.h>
+
+#include "mfvio.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define MFV_MAGIC               "MAMEMFV\x1a"
+#define MFV_VERSION             1
+
+#define MFV_HEADER_SIZE         48
+#define MFV_CHUNK_HEADER_SIZE   12
+
+#define MFV_CHUNK_VIDEO         'V'
+#define MFV_CHUNK_AUDIO         'A'
+
+#define MFV_FLAG_KEYFRAME       0x01
+#define MFV_FLAG_REPEAT         0x02
+
+#define MFV_KEYFRAME_INTERVAL   600         /* frames between keyframes */
+#define MFV_MAX_DIMENSION       16384       /* keeps max_residual_size() within 32 bits */
+#define MFV_MAX_AUDIO_CHANNELS  2
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct mfv_file
+{
+	core_file *         file;               /* pointer to open file */
+	int                 writing;            /* TRUE if we are creating the file */
+	mfv_movie_info      info;               /* movie info */
+
+	UINT32 *            prevframe;          /* previous frame, as 0x00RRGGBB */
+	UINT32              keycountdown;       /* frames until the next keyframe */
+
+	UINT8 *             residual;           /* uncompressed frame residual */
+	UINT32              residualsize;       /* size of the residual buffer */
+	UINT8 *             packed;             /* compressed chunk payload */
+	UINT32              packedsize;         /* size of the payload buffer */
+
+	z_stream            zstream;            /* deflate/inflate stream */
+	int                 zstream_inited;     /* TRUE if the stream has been set up */
+};
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    fetch_16bits - read 16 bits in LSB order
+    from the given buffer
+-------------------------------------------------*/
+
+INLINE UINT16 fetch_16bits(const UINT8 *data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+
+/*-------------------------------------------------
+    fetch_32bits - read 32 bits in LSB order
+    from the given buffer
+-------------------------------------------------*/
+
+INLINE UINT32 fetch_32bits(const UINT8 *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+}
+
+
+/*-------------------------------------------------
+    put_16bits - write 16 bits in LSB order
+    to the given buffer
+-------------------------------------------------*/
+
+INLINE void put_16bits(UINT8 *data, UINT16 value)
+{
+	data[0] = value >> 0;
+	data[1] = value >> 8;
+}
+
+
+/*-------------------------------------------------
+    put_32bits - write 32 bits in LSB order
+    to the given buffer
+-------------------------------------------------*/
+
+INLINE void put_32bits(UINT8 *data, UINT32 value)
+{
+	data[0] = value >> 0;
+	data[1] = value >> 8;
+	data[2] = value >> 16;
+	data[3] = value >> 24;
+}
+
+
+/*-------------------------------------------------
+    frame_pixels - return the number of pixels in
+    a frame
+-------------------------------------------------*/
+
+INLINE UINT32 frame_pixels(const mfv_file *file)
+{
+	return file->info.video_width * file->info.video_height;
+}
+
+
+/*-------------------------------------------------
+    max_residual_size - return the worst-case
+    size of a frame's residual
+-------------------------------------------------*/
+
+INLINE UINT32 max_residual_size(const mfv_file *file)
+{
+	return (file->info.video_height + 7) / 8 + file->info.video_height * (4 + 3 * file->info.video_width);
+}
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    write_header - write the file header at the
+    current position
+-------------------------------------------------*/
+
+static mfv_error write_header(mfv_file *file)
+{
+	UINT8 header[MFV_HEADER_SIZE];
+
+	memset(header, 0, sizeof(header));
+	memcpy(&header[0], MFV_MAGIC, 8);
+	put_32bits(&header[8], MFV_VERSION);
+	put_32bits(&header[12], file->info.video_width);
+	put_32bits(&header[16], file->info.video_height);
+	put_32bits(&header[20], file->info.video_timescale);
+	put_32bits(&header[24], file->info.video_sampletime);
+	put_32bits(&header[28], file->info.video_numframes);
+	put_32bits(&header[32], file->info.audio_samplerate);
+	put_32bits(&header[36], file->info.audio_channels);
+	put_32bits(&header[40], file->info.audio_numsamples);
+
+	if (core_fwrite(file->file, header, sizeof(header)) != sizeof(header))
+		return MFVERR_WRITE_ERROR;
+	return MFVERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    write_chunk - write a chunk header followed
+    by its payload
+-------------------------------------------------*/
+
+static mfv_error write_chunk(mfv_file *file, UINT8 type, UINT8 flags, UINT32 count, const void *data, UINT32 length)
+{
+	UINT8 header[MFV_CHUNK_HEADER_SIZE];
+
+	header[0] = type;
+	header[1] = flags;
+	put_16bits(&header[2], 0);
+	put_32bits(&header[4], length);
+	put_32bits(&header[8], count);
+
+	if (core_fwrite(file->file, header, sizeof(header)) != sizeof(header))
+		return MFVERR_WRITE_ERROR;
+	if (length != 0 && core_fwrite(file->file, data, length) != length)
+		return MFVERR_WRITE_ERROR;
+	return MFVERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    encode_residual - compute the residual of a
+    frame against the previous one, updating the
+    previous frame; returns the residual length,
+    or 0 if nothing changed
+-------------------------------------------------*/
+
+static UINT32 encode_residual(mfv_file *file, bitmap_rgb32 &bitmap)
+{
+	UINT32 width = file->info.video_width;
+	UINT32 height = file->info.video_height;
+	UINT8 *rowmask = file->residual;
+	UINT8 *dest = rowmask + (height + 7) / 8;
+	int changed = FALSE;
+	UINT32 x, y;
+
+	memset(rowmask, 0, (height + 7) / 8);
+	for (y = 0; y < height; y++)
+	{
+		const UINT32 *src = &bitmap.pix32(y);
+		UINT32 *prev = &file->prevframe[y * width];
+		UINT32 first, last;
+
+		/* find the changed span of this row */
+		for (first = 0; first < width; first++)
+			if (((src[first] ^ prev[first]) & 0xffffff) != 0)
+				break;
+		if (first == width)
+			continue;
+		for (last = width - 1; last > first; last--)
+			if (((src[last] ^ prev[last]) & 0xffffff) != 0)
+				break;
+
+		/* emit the span */
+		rowmask[y / 8] |= 1 << (y % 8);
+		put_16bits(&dest[0], first);
+		put_16bits(&dest[2], last + 1 - first);
+		dest += 4;
+		for (x = first; x <= last; x++)
+		{
+			UINT32 delta = src[x] ^ prev[x];
+			*dest++ = delta >> 16;
+			*dest++ = delta >> 8;
+			*dest++ = delta >> 0;
+			prev[x] = src[x] & 0xffffff;
+		}
+		changed = TRUE;
+	}
+	return changed ? dest - file->residual : 0;
+}
+
+
+/*-------------------------------------------------
+    decode_residual - apply a residual to the
+    previous frame
+-------------------------------------------------*/
+
+static mfv_error decode_residual(mfv_file *file, UINT32 length)
+{
+	UINT32 width = file->info.video_width;
+	UINT32 height = file->info.video_height;
+	const UINT8 *rowmask = file->residual;
+	const UINT8 *src = rowmask + (height + 7) / 8;
+	const UINT8 *srcend = file->residual + length;
+	UINT32 x, y;
+
+	if (src > srcend)
+		return MFVERR_INVALID_DATA;
+	for (y = 0; y < height; y++)
+		if (rowmask[y / 8] & (1 << (y % 8)))
+		{
+			UINT32 *prev = &file->prevframe[y * width];
+			UINT32 first, count;
+
+			/* validate the span */
+			if (srcend - src < 4)
+				return MFVERR_INVALID_DATA;
+			first = fetch_16bits(&src[0]);
+			count = fetch_16bits(&src[2]);
+			src += 4;
+			if (first + count > width || (UINT32)(srcend - src) < 3 * count)
+				return MFVERR_INVALID_DATA;
+
+			/* apply it */
+			for (x = first; x < first + count; x++, src += 3)
+				prev[x] ^= (src[0] << 16) | (src[1] << 8) | src[2];
+		}
+	return (src == srcend) ? MFVERR_NONE : MFVERR_INVALID_DATA;
+}
+
+
+/*-------------------------------------------------
+    allocate_buffers - allocate the frame and
+    residual buffers for a file
+-------------------------------------------------*/
+
+static mfv_error allocate_buffers(mfv_file *file)
+{
+	file->prevframe = (UINT32 *)malloc(frame_pixels(file) * sizeof(file->prevframe[0]));
+	file->residualsize = max_residual_size(file);
+	file->residual = (UINT8 *)malloc(file->residualsize);
+	if (file->prevframe == NULL || file->residual == NULL)
+		return MFVERR_NO_MEMORY;
+	memset(file->prevframe, 0, frame_pixels(file) * sizeof(file->prevframe[0]));
+	return MFVERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    free_file - release a file and everything it
+    owns, leaving the core_file open
+-------------------------------------------------*/
+
+static void free_file(mfv_file *file)
+{
+	if (file->zstream_inited)
+	{
+		if (file->writing)
+			deflateEnd(&file->zstream);
+		else
+			inflateEnd(&file->zstream);
+	}
+	if (file->prevframe != NULL)
+		free(file->prevframe);
+	if (file->residual != NULL)
+		free(file->residual);
+	if (file->packed != NULL)
+		free(file->packed);
+	free(file);
+}
+
+
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    mfv_create - start writing a new movie to an
+    open file
+-------------------------------------------------*/
+
+mfv_error mfv_create(core_file *fp, const mfv_movie_info *info, mfv_file **file)
+{
+	mfv_file *newfile;
+	mfv_error mfverr;
+
+	/* validate the info */
+	if (info->video_width == 0 || info->video_width > MFV_MAX_DIMENSION ||
+		info->video_height == 0 || info->video_height > MFV_MAX_DIMENSION ||
+		info->video_timescale == 0 || info->video_sampletime == 0 ||
+		info->audio_channels > MFV_MAX_AUDIO_CHANNELS || (info->audio_samplerate != 0 && info->audio_channels == 0))
+		return MFVERR_INVALID_DATA;
+
+	/* allocate the file */
+	newfile = (mfv_file *)malloc(sizeof(*newfile));
+	if (newfile == NULL)
+		return MFVERR_NO_MEMORY;
+	memset(newfile, 0, sizeof(*newfile));
+	newfile->file = fp;
+	newfile->writing = TRUE;
+	newfile->info = *info;
+	newfile->info.video_numframes = 0;
+	newfile->info.audio_numsamples = 0;
+	if (newfile->info.audio_samplerate == 0)
+		newfile->info.audio_channels = 0;
+
+	/* allocate buffers; the payload can never exceed the deflate bound of the residual */
+	mfverr = allocate_buffers(newfile);
+	if (mfverr != MFVERR_NONE)
+		goto error;
+	if (deflateInit2(&newfile->zstream, Z_BEST_SPEED, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		mfverr = MFVERR_COMPRESS_ERROR;
+		goto error;
+	}
+	newfile->zstream_inited = TRUE;
+	newfile->packedsize = deflateBound(&newfile->zstream, newfile->residualsize);
+	if (newfile->packedsize < MFV_MAX_AUDIO_SAMPLES * MFV_MAX_AUDIO_CHANNELS * 2)
+		newfile->packedsize = MFV_MAX_AUDIO_SAMPLES * MFV_MAX_AUDIO_CHANNELS * 2;
+	newfile->packed = (UINT8 *)malloc(newfile->packedsize);
+	if (newfile->packed == NULL)
+	{
+		mfverr = MFVERR_NO_MEMORY;
+		goto error;
+	}
+
+	/* write the initial header */
+	mfverr = write_header(newfile);
+	if (mfverr != MFVERR_NONE)
+		goto error;
+
+	*file = newfile;
+	return MFVERR_NONE;
+
+error:
+	free_file(newfile);
+	return mfverr;
+}
+
+
+/*-------------------------------------------------
+    mfv_open - start reading a movie from an open
+    file
+-------------------------------------------------*/
+
+mfv_error mfv_open(core_file *fp, mfv_file **file)
+{
+	UINT8 header[MFV_HEADER_SIZE];
+	mfv_file *newfile;
+	mfv_error mfverr;
+
+	/* read and validate the header */
+	if (core_fread(fp, header, sizeof(header)) != sizeof(header))
+		return MFVERR_READ_ERROR;
+	if (memcmp(&header[0], MFV_MAGIC, 8) != 0)
+		return MFVERR_INVALID_DATA;
+	if (fetch_32bits(&header[8]) != MFV_VERSION)
+		return MFVERR_UNSUPPORTED_VERSION;
+
+	/* allocate the file */
+	newfile = (mfv_file *)malloc(sizeof(*newfile));
+	if (newfile == NULL)
+		return MFVERR_NO_MEMORY;
+	memset(newfile, 0, sizeof(*newfile));
+	newfile->file = fp;
+	newfile->writing = FALSE;
+	newfile->info.video_width = fetch_32bits(&header[12]);
+	newfile->info.video_height = fetch_32bits(&header[16]);
+	newfile->info.video_timescale = fetch_32bits(&header[20]);
+	newfile->info.video_sampletime = fetch_32bits(&header[24]);
+	newfile->info.video_numframes = fetch_32bits(&header[28]);
+	newfile->info.audio_samplerate = fetch_32bits(&header[32]);
+	newfile->info.audio_channels = fetch_32bits(&header[36]);
+	newfile->info.audio_numsamples = fetch_32bits(&header[40]);
+	if (newfile->info.video_width == 0 || newfile->info.video_width > MFV_MAX_DIMENSION ||
+		newfile->info.video_height == 0 || newfile->info.video_height > MFV_MAX_DIMENSION ||
+		newfile->info.audio_channels > MFV_MAX_AUDIO_CHANNELS)
+	{
+		mfverr = MFVERR_INVALID_DATA;
+		goto error;
+	}
+
+	/* allocate buffers */
+	mfverr = allocate_buffers(newfile);
+	if (mfverr != MFVERR_NONE)
+		goto error;
+	if (inflateInit2(&newfile->zstream, -15) != Z_OK)
+	{
+		mfverr = MFVERR_DECOMPRESS_ERROR;
+		goto error;
+	}
+	newfile->zstream_inited = TRUE;
+
+	*file = newfile;
+	return MFVERR_NONE;
+
+error:
+	free_file(newfile);
+	return mfverr;
+}
+
+
+/*-------------------------------------------------
+    mfv_close - finish a movie, updating the
+    header if it was being written; the
+    underlying file is left open
+-------------------------------------------------*/
+
+mfv_error mfv_close(mfv_file *file)
+{
+	mfv_error mfverr = MFVERR_NONE;
+
+	/* rewrite the header with the final counts */
+	if (file->writing)
+	{
+		if (core_fseek(file->file, 0, SEEK_SET) != 0)
+			mfverr = MFVERR_WRITE_ERROR;
+		else
+			mfverr = write_header(file);
+		core_fseek(file->file, 0, SEEK_END);
+	}
+
+	free_file(file);
+	return mfverr;
+}
+
+
+/*-------------------------------------------------
+    mfv_error_string - get the error string for
+    an mfv_error
+-------------------------------------------------*/
+
+const char *mfv_error_string(mfv_error err)
+{
+	switch (err)
+	{
+		case MFVERR_NONE:                   return "success";
+		case MFVERR_END:                    return "hit end of file";
+		case MFVERR_INVALID_DATA:           return "invalid data";
+		case MFVERR_UNSUPPORTED_VERSION:    return "unsupported version";
+		case MFVERR_NO_MEMORY:              return "out of memory";
+		case MFVERR_READ_ERROR:             return "read error";
+		case MFVERR_WRITE_ERROR:            return "write error";
+		case MFVERR_COMPRESS_ERROR:         return "compression error";
+		case MFVERR_DECOMPRESS_ERROR:       return "decompression error";
+		case MFVERR_INVALID_BITMAP:         return "invalid bitmap";
+		default:                            return "undocumented error";
+	}
+}
+
+
+/*-------------------------------------------------
+    mfv_get_movie_info - return the movie info
+-------------------------------------------------*/
+
+const mfv_movie_info *mfv_get_movie_info(mfv_file *file)
+{
+	return &file->info;
+}
+
+
+/*-------------------------------------------------
+    mfv_append_video_frame - append a frame of
+    video
+-------------------------------------------------*/
+
+mfv_error mfv_append_video_frame(mfv_file *file, bitmap_rgb32 &bitmap)
+{
+	UINT8 flags = 0;
+	UINT32 length;
+
+	/* the bitmap must match the movie dimensions */
+	if (bitmap.width() != file->info.video_width || bitmap.height() != file->info.video_height)
+		return MFVERR_INVALID_BITMAP;
+
+	/* periodically encode against black instead of the previous frame */
+	if (file->keycountdown == 0)
+	{
+		memset(file->prevframe, 0, frame_pixels(file) * sizeof(file->prevframe[0]));
+		file->keycountdown = MFV_KEYFRAME_INTERVAL;
+		flags |= MFV_FLAG_KEYFRAME;
+	}
+	file->keycountdown--;
+
+	/* an unchanged frame is just a repeat marker; a black keyframe is still a keyframe */
+	length = encode_residual(file, bitmap);
+	if (length == 0 && !(flags & MFV_FLAG_KEYFRAME))
+	{
+		file->info.video_numframes++;
+		return write_chunk(file, MFV_CHUNK_VIDEO, MFV_FLAG_REPEAT, 0, NULL, 0);
+	}
+	if (length == 0)
+	{
+		memset(file->residual, 0, (file->info.video_height + 7) / 8);
+		length = (file->info.video_height + 7) / 8;
+	}
+
+	/* deflate the residual */
+	deflateReset(&file->zstream);
+	file->zstream.next_in = file->residual;
+	file->zstream.avail_in = length;
+	file->zstream.next_out = file->packed;
+	file->zstream.avail_out = file->packedsize;
+	if (deflate(&file->zstream, Z_FINISH) != Z_STREAM_END)
+		return MFVERR_COMPRESS_ERROR;
+
+	file->info.video_numframes++;
+	return write_chunk(file, MFV_CHUNK_VIDEO, flags, length, file->packed, file->packedsize - file->zstream.avail_out);
+}
+
+
+/*-------------------------------------------------
+    mfv_append_sound_samples - append interleaved
+    sound samples
+-------------------------------------------------*/
+
+mfv_error mfv_append_sound_samples(mfv_file *file, const INT16 *samples, UINT32 numsamples)
+{
+	UINT32 channels = file->info.audio_channels;
+
+	if (channels == 0)
+		return MFVERR_NONE;
+
+	/* write in chunks no larger than a reader is guaranteed to handle */
+	while (numsamples > 0)
+	{
+		UINT32 chunksamples = MIN(numsamples, MFV_MAX_AUDIO_SAMPLES);
+		UINT32 sampnum;
+		mfv_error mfverr;
+
+		for (sampnum = 0; sampnum < chunksamples * channels; sampnum++)
+			put_16bits(&file->packed[sampnum * 2], *samples++);
+		mfverr = write_chunk(file, MFV_CHUNK_AUDIO, 0, chunksamples, file->packed, chunksamples * channels * 2);
+		if (mfverr != MFVERR_NONE)
+			return mfverr;
+
+		file->info.audio_numsamples += chunksamples;
+		numsamples -= chunksamples;
+	}
+	return MFVERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    mfv_read_next - read the next chunk of the
+    movie; video frames are returned in bitmap,
+    which is reallocated if needed, and audio in
+    samples, which must hold MFV_MAX_AUDIO_SAMPLES
+    for each channel
+-------------------------------------------------*/
+
+mfv_error mfv_read_next(mfv_file *file, mfv_datatype *type, bitmap_rgb32 &bitmap, INT16 *samples, UINT32 *numsamples)
+{
+	UINT8 header[MFV_CHUNK_HEADER_SIZE];
+	UINT32 length, count;
+	UINT32 x, y;
+
+	/* read the chunk header */
+	length = core_fread(file->file, header, sizeof(header));
+	if (length == 0)
+		return MFVERR_END;
+	if (length != sizeof(header))
+		return MFVERR_READ_ERROR;
+	length = fetch_32bits(&header[4]);
+	count = fetch_32bits(&header[8]);
+
+	if (header[0] != MFV_CHUNK_AUDIO && header[0] != MFV_CHUNK_VIDEO)
+		return MFVERR_INVALID_DATA;
+
+	/* read the payload */
+	if (length > file->packedsize)
+	{
+		UINT8 *newpacked = (UINT8 *)realloc(file->packed, length);
+		if (newpacked == NULL)
+			return MFVERR_NO_MEMORY;
+		file->packed = newpacked;
+		file->packedsize = length;
+	}
+	if (length != 0 && core_fread(file->file, file->packed, length) != length)
+		return MFVERR_READ_ERROR;
+
+	/* audio chunks are stored as-is */
+	if (header[0] == MFV_CHUNK_AUDIO)
+	{
+		UINT32 sampnum;
+
+		if (count > MFV_MAX_AUDIO_SAMPLES || length != count * file->info.audio_channels * 2)
+			return MFVERR_INVALID_DATA;
+		for (sampnum = 0; sampnum < count * file->info.audio_channels; sampnum++)
+			samples[sampnum] = (INT16)fetch_16bits(&file->packed[sampnum * 2]);
+		*type = MFVDATA_AUDIO;
+		*numsamples = count;
+		return MFVERR_NONE;
+	}
+
+	/* apply the residual unless this frame is a repeat */
+	if (!(header[1] & MFV_FLAG_REPEAT))
+	{
+		mfv_error mfverr;
+
+		if (count > file->residualsize)
+			return MFVERR_INVALID_DATA;
+		inflateReset(&file->zstream);
+		file->zstream.next_in = file->packed;
+		file->zstream.avail_in = length;
+		file->zstream.next_out = file->residual;
+		file->zstream.avail_out = count;
+		if (inflate(&file->zstream, Z_FINISH) != Z_STREAM_END || file->zstream.avail_out != 0)
+			return MFVERR_DECOMPRESS_ERROR;
+
+		if (header[1] & MFV_FLAG_KEYFRAME)
+			memset(file->prevframe, 0, frame_pixels(file) * sizeof(file->prevframe[0]));
+		mfverr = decode_residual(file, count);
+		if (mfverr != MFVERR_NONE)
+			return mfverr;
+	}
+
+	/* copy the frame out */
+	if (bitmap.width() != file->info.video_width || bitmap.height() != file->info.video_height)
+		bitmap.allocate(file->info.video_width, file->info.video_height);
+	for (y = 0; y < file->info.video_height; y++)
+	{
+		const UINT32 *src = &file->prevframe[y * file->info.video_width];
+		UINT32 *dest = &bitmap.pix32(y);
+		for (x = 0; x < file->info.video_width; x++)
+			dest[x] = 0xff000000 | src[x];
+	}
+	*type = MFVDATA_VIDEO;
+	return MFVERR_NONE;
+}
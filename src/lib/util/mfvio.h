@@ -0,0 +1,89 @@
+/***************************************************************************
+
+    mfvio.h
+
+    Fast lossless inter-frame movie format for emulated video.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#ifndef __MFVIO_H__
+#define __MFVIO_H__
+
+#include "osdcore.h"
+#include "bitmap.h"
+#include "corefile.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+enum mfv_error
+{
+	MFVERR_NONE = 0,
+	MFVERR_END,
+	MFVERR_INVALID_DATA,
+	MFVERR_UNSUPPORTED_VERSION,
+	MFVERR_NO_MEMORY,
+	MFVERR_READ_ERROR,
+	MFVERR_WRITE_ERROR,
+	MFVERR_COMPRESS_ERROR,
+	MFVERR_DECOMPRESS_ERROR,
+	MFVERR_INVALID_BITMAP
+};
+
+
+enum mfv_datatype
+{
+	MFVDATA_VIDEO,
+	MFVDATA_AUDIO
+};
+
+
+/* largest number of samples (per channel) carried by a single audio chunk */
+#define MFV_MAX_AUDIO_SAMPLES   16384
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct mfv_file;
+
+
+struct mfv_movie_info
+{
+	UINT32          video_timescale;            /* timescale for video data */
+	UINT32          video_sampletime;           /* duration of a single video frame */
+	UINT32          video_numframes;            /* total number of video frames */
+	UINT32          video_width;                /* width of the video */
+	UINT32          video_height;               /* height of the video */
+
+	UINT32          audio_samplerate;           /* sample rate of audio, or 0 for none */
+	UINT32          audio_channels;             /* number of interleaved 16-bit audio channels */
+	UINT32          audio_numsamples;           /* total number of audio samples per channel */
+};
+
+
+
+/***************************************************************************
+    PROTOTYPES
+***************************************************************************/
+
+mfv_error mfv_create(core_file *fp, const mfv_movie_info *info, mfv_file **file);
+mfv_error mfv_open(core_file *fp, mfv_file **file);
+mfv_error mfv_close(mfv_file *file);
+
+const char *mfv_error_string(mfv_error err);
+const mfv_movie_info *mfv_get_movie_info(mfv_file *file);
+
+mfv_error mfv_append_video_frame(mfv_file *file, bitmap_rgb32 &bitmap);
+mfv_error mfv_append_sound_samples(mfv_file *file, const INT16 *samples, UINT32 numsamples);
+
+mfv_error mfv_read_next(mfv_file *file, mfv_datatype *type, bitmap_rgb32 &bitmap, INT16 *samples, UINT32 *numsamples);
+
+#endif
@@ -39,6 +39,24 @@ struct png_private
 };
 
 
+/* a band of rows that is filtered and deflated independently of the others */
+struct png_band
+{
+	const UINT8 *       image;          /* unfiltered image, with a filter byte per row */
+	UINT8 *             filtered;       /* filtered image, same layout */
+	UINT32              rowbytes;       /* bytes per row, excluding the filter byte */
+	UINT32              bpp;            /* bytes per complete pixel */
+	int                 nofilter;       /* true to store every row with no filter */
+	UINT32              startrow;       /* first row in the band */
+	UINT32              rows;           /* number of rows in the band */
+	int                 last;           /* true for the band that finishes the stream */
+	UINT8 *             zdata;          /* raw deflate output */
+	UINT32              zlength;        /* bytes of raw deflate output */
+	UINT32              adler;          /* adler32 of the band's filtered data */
+	png_error           error;          /* result */
+};
+
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -46,6 +64,14 @@ struct png_private
 
 static const int samples[] = { 1, 0, 3, 1, 2, 0, 4 };
 
+/* images with more filtered data than this are split into bands, one per
+   PNG_BAND_BYTES, and compressed on multiple threads */
+#define PNG_BAND_BYTES      (128 * 1024)
+#define PNG_MAX_BANDS       16
+
+/* each band's compressor is primed with this much of the data before it */
+#define PNG_DICT_BYTES      32768
+
 
 
 /***************************************************************************
@@ -778,88 +804,288 @@ static png_error write_chunk(core_file *fp, const UINT8 *data, UINT32 type, UINT
 
 
 /*-------------------------------------------------
-    write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    paeth_predictor - PNG Paeth prediction from
+    the left, up and upper-left bytes
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, UINT32 length)
+INLINE int paeth_predictor(int a, int b, int c)
 {
-	UINT64 lengthpos = core_ftell(fp);
-	UINT8 tempbuff[8192];
-	UINT32 zlength = 0;
-	z_stream stream;
-	UINT32 crc;
-	int zerr;
+	int prediction = a + b - c;
+	int da = abs(prediction - a);
+	int db = abs(prediction - b);
+	int dc = abs(prediction - c);
+	if (da <= db && da <= dc)
+		return a;
+	else if (db <= dc)
+		return b;
+	return c;
+}
 
-	/* stuff the length/type into the buffer */
-	put_32bit(tempbuff + 0, length);
-	put_32bit(tempbuff + 4, type);
-	crc = crc32(0, tempbuff + 4, 4);
 
-	/* write that data */
-	if (core_fwrite(fp, tempbuff, 8) != 8)
-		return PNGERR_FILE_ERROR;
+/*-------------------------------------------------
+    filter_row - filter a single row of pixels,
+    picking the filter whose output has the
+    smallest sum of absolute (signed) values
+-------------------------------------------------*/
 
-	/* initialize the stream */
-	memset(&stream, 0, sizeof(stream));
-	stream.next_in = data;
-	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+static void filter_row(UINT8 *dst, const UINT8 *src, const UINT8 *prev, UINT32 bpp, UINT32 rowbytes)
+{
+	UINT32 sums[5] = { 0 };
+	UINT32 x;
+	UINT32 type;
 
-	/* now loop until we run out of data */
-	for ( ; ; )
+	/* a row repeating the one above filters to all zeros with UP */
+	if (prev != NULL && memcmp(src, prev, rowbytes) == 0)
 	{
-		/* compress this chunk */
-		stream.next_out = tempbuff;
-		stream.avail_out = sizeof(tempbuff);
-		zerr = deflate(&stream, Z_FINISH);
+		*dst++ = PNG_PF_Up;
+		memset(dst, 0, rowbytes);
+		return;
+	}
 
-		/* if there's data to write, do it */
-		if (stream.avail_out < sizeof(tempbuff))
+	/* measure every filter */
+	for (x = 0; x < rowbytes; x++)
+	{
+		int cur = src[x];
+		int a = (x < bpp) ? 0 : src[x - bpp];
+		int b = (prev == NULL) ? 0 : prev[x];
+		int c = (x < bpp || prev == NULL) ? 0 : prev[x - bpp];
+		sums[PNG_PF_None] += abs((INT8)cur);
+		sums[PNG_PF_Sub] += abs((INT8)(cur - a));
+		sums[PNG_PF_Up] += abs((INT8)(cur - b));
+		sums[PNG_PF_Average] += abs((INT8)(cur - ((a + b) >> 1)));
+		sums[PNG_PF_Paeth] += abs((INT8)(cur - paeth_predictor(a, b, c)));
+	}
+	type = PNG_PF_None;
+	for (x = PNG_PF_Sub; x <= PNG_PF_Paeth; x++)
+		if (sums[x] < sums[type])
+			type = x;
+
+	/* then apply the winner */
+	*dst++ = type;
+	for (x = 0; x < rowbytes; x++)
+	{
+		int a = (x < bpp) ? 0 : src[x - bpp];
+		int b = (prev == NULL) ? 0 : prev[x];
+		int c = (x < bpp || prev == NULL) ? 0 : prev[x - bpp];
+		switch (type)
 		{
-			int bytes = sizeof(tempbuff) - stream.avail_out;
-			if (core_fwrite(fp, tempbuff, bytes) != bytes)
-			{
-				deflateEnd(&stream);
-				return PNGERR_FILE_ERROR;
-			}
-			crc = crc32(crc, tempbuff, bytes);
-			zlength += bytes;
+			case PNG_PF_None:       dst[x] = src[x];                                break;
+			case PNG_PF_Sub:        dst[x] = src[x] - a;                            break;
+			case PNG_PF_Up:         dst[x] = src[x] - b;                            break;
+			case PNG_PF_Average:    dst[x] = src[x] - ((a + b) >> 1);               break;
+			case PNG_PF_Paeth:      dst[x] = src[x] - paeth_predictor(a, b, c);     break;
 		}
+	}
+}
 
-		/* stop at the end of the stream */
-		if (zerr == Z_STREAM_END)
-			break;
 
-		/* other errors are fatal */
-		if (zerr != Z_OK)
+/*-------------------------------------------------
+    filter_band - work item that filters the rows
+    of a band
+-------------------------------------------------*/
+
+static void *filter_band(void *param, int threadid)
+{
+	png_band *band = (png_band *)param;
+	UINT32 stride = band->rowbytes + 1;
+	UINT32 y;
+
+	for (y = band->startrow; y < band->startrow + band->rows; y++)
+	{
+		const UINT8 *src = band->image + y * stride + 1;
+		UINT8 *dst = band->filtered + y * stride;
+
+		/* palettized images are left unfiltered, as the PNG spec recommends; so
+		   are images in a single band, since filtered rows take longer to deflate
+		   and only the parallel bands win that time back */
+		if (band->nofilter)
 		{
-			deflateEnd(&stream);
-			return PNGERR_COMPRESS_ERROR;
+			*dst = PNG_PF_None;
+			memcpy(dst + 1, src, band->rowbytes);
 		}
+		else
+			filter_row(dst, src, (y == 0) ? NULL : src - stride, band->bpp, band->rowbytes);
 	}
+	return NULL;
+}
 
-	/* clean up deflater(maus) */
-	zerr = deflateEnd(&stream);
+
+/*-------------------------------------------------
+    deflate_band - work item that deflates the
+    filtered rows of a band into a raw deflate
+    stream that ends on a byte boundary, so that
+    the bands can simply be concatenated
+-------------------------------------------------*/
+
+static void *deflate_band(void *param, int threadid)
+{
+	png_band *band = (png_band *)param;
+	UINT32 stride = band->rowbytes + 1;
+	UINT8 *data = band->filtered + band->startrow * stride;
+	UINT32 length = band->rows * stride;
+	z_stream stream;
+	UINT32 bound;
+	int zerr;
+
+	band->adler = adler32(adler32(0, NULL, 0), data, length);
+
+	/* initialize a raw stream; the zlib header and trailer are written around all the bands */
+	memset(&stream, 0, sizeof(stream));
+	zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
 	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+	{
+		band->error = PNGERR_COMPRESS_ERROR;
+		return NULL;
+	}
 
-	/* write the CRC */
-	put_32bit(tempbuff, crc);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
+	/* prime it with the data before the band, which the decompressor will already have seen */
+	if (band->startrow > 0)
+	{
+		UINT32 dictlength = MIN(band->startrow * stride, PNG_DICT_BYTES);
+		zerr = deflateSetDictionary(&stream, data - dictlength, dictlength);
+	}
+
+	/* allow for the flush marker on top of the usual bound */
+	bound = deflateBound(&stream, length) + 16;
+	band->zdata = (UINT8 *)malloc(bound);
+	if (band->zdata == NULL)
+	{
+		deflateEnd(&stream);
+		band->error = PNGERR_OUT_OF_MEMORY;
+		return NULL;
+	}
+
+	/* compress it all in one go */
+	stream.next_in = data;
+	stream.avail_in = length;
+	stream.next_out = band->zdata;
+	stream.avail_out = bound;
+	if (zerr == Z_OK)
+		zerr = deflate(&stream, band->last ? Z_FINISH : Z_FULL_FLUSH);
+	band->zlength = bound - stream.avail_out;
+	if (zerr != (band->last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0)
+		band->error = PNGERR_COMPRESS_ERROR;
+
+	/* clean up deflater(maus) */
+	deflateEnd(&stream);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    write_image_chunk - filter and deflate the
+    image, in parallel bands on the given queue
+    if it is large, and write it as a single IDAT
+    chunk; only one thread may use a queue here
+    at a time
+-------------------------------------------------*/
 
-	/* seek back and update the length */
-	core_fseek(fp, lengthpos, SEEK_SET);
+static png_error write_image_chunk(core_file *fp, png_info *pnginfo, osd_work_queue *queue)
+{
+	png_band bands[PNG_MAX_BANDS];
+	UINT32 rowbytes = compute_rowbytes(pnginfo);
+	UINT32 length = pnginfo->height * (rowbytes + 1);
+	UINT32 numbands, rowsperband, bandnum;
+	UINT32 zlength, adler;
+	png_error error = PNGERR_NONE;
+	UINT8 *filtered;
+	UINT8 tempbuff[8];
+	UINT32 crc;
+
+	/* split into bands of whole rows, if there is a queue to run them on */
+	numbands = (queue != NULL) ? MAX(1, MIN(PNG_MAX_BANDS, length / PNG_BAND_BYTES)) : 1;
+	numbands = MIN(numbands, pnginfo->height);
+	rowsperband = (pnginfo->height + numbands - 1) / numbands;
+	numbands = (pnginfo->height + rowsperband - 1) / rowsperband;
+
+	filtered = (UINT8 *)malloc(length);
+	if (filtered == NULL)
+		return PNGERR_OUT_OF_MEMORY;
+
+	memset(bands, 0, sizeof(bands));
+	for (bandnum = 0; bandnum < numbands; bandnum++)
+	{
+		png_band *band = &bands[bandnum];
+		band->image = pnginfo->image;
+		band->filtered = filtered;
+		band->rowbytes = rowbytes;
+		band->bpp = MAX(1, compute_bpp(pnginfo));
+		band->nofilter = (pnginfo->color_type == 3 || numbands == 1);
+		band->startrow = bandnum * rowsperband;
+		band->rows = MIN(rowsperband, pnginfo->height - band->startrow);
+		band->last = (bandnum == numbands - 1);
+		band->error = PNGERR_NONE;
+	}
+
+	/* filter all the bands, then deflate them */
+	if (numbands > 1)
+	{
+		/* deflate primes its dictionary with the filtered rows above each band,
+		   so every band has to be filtered before any is deflated */
+		osd_work_item_run_multiple(queue, filter_band, numbands, bands, sizeof(bands[0]));
+		osd_work_item_run_multiple(queue, deflate_band, numbands, bands, sizeof(bands[0]));
+	}
+	else
+	{
+		filter_band(&bands[0], 0);
+		deflate_band(&bands[0], 0);
+	}
+
+	/* total up the compressed size and combine the checksums */
+	zlength = 2 + 4;
+	adler = adler32(0, NULL, 0);
+	for (bandnum = 0; bandnum < numbands; bandnum++)
+	{
+		if (bands[bandnum].error != PNGERR_NONE && error == PNGERR_NONE)
+			error = bands[bandnum].error;
+		zlength += bands[bandnum].zlength;
+		adler = adler32_combine(adler, bands[bandnum].adler, bands[bandnum].rows * (rowbytes + 1));
+	}
+	if (error != PNGERR_NONE)
+		goto cleanup;
+
+	/* write the chunk header followed by the zlib header */
 	put_32bit(tempbuff + 0, zlength);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
+	put_32bit(tempbuff + 4, PNG_CN_IDAT);
+	if (core_fwrite(fp, tempbuff, 8) != 8)
+	{
+		error = PNGERR_FILE_ERROR;
+		goto cleanup;
+	}
+	crc = crc32(0, tempbuff + 4, 4);
+	tempbuff[0] = 0x78;
+	tempbuff[1] = 0x9c;
+	crc = crc32(crc, tempbuff, 2);
+	if (core_fwrite(fp, tempbuff, 2) != 2)
+	{
+		error = PNGERR_FILE_ERROR;
+		goto cleanup;
+	}
 
-	/* return to the end */
-	core_fseek(fp, lengthpos + 8 + zlength + 4, SEEK_SET);
-	return PNGERR_NONE;
+	/* then each band's data */
+	for (bandnum = 0; bandnum < numbands; bandnum++)
+	{
+		crc = crc32(crc, bands[bandnum].zdata, bands[bandnum].zlength);
+		if (core_fwrite(fp, bands[bandnum].zdata, bands[bandnum].zlength) != bands[bandnum].zlength)
+		{
+			error = PNGERR_FILE_ERROR;
+			goto cleanup;
+		}
+	}
+
+	/* and finally the zlib trailer and the CRC */
+	put_32bit(tempbuff + 0, adler);
+	crc = crc32(crc, tempbuff, 4);
+	put_32bit(tempbuff + 4, crc);
+	if (core_fwrite(fp, tempbuff, 8) != 8)
+		error = PNGERR_FILE_ERROR;
+
+cleanup:
+	for (bandnum = 0; bandnum < numbands; bandnum++)
+		if (bands[bandnum].zdata != NULL)
+			free(bands[bandnum].zdata);
+	free(filtered);
+	return error;
 }
 
 
@@ -1005,7 +1231,7 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
     chunks to the given file
 -------------------------------------------------*/
 
-static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
 	UINT8 tempbuff[16];
 	png_text *text;
@@ -1019,8 +1245,6 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
-
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
 	put_32bit(tempbuff + 4, pnginfo->height);
@@ -1040,7 +1264,7 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 		goto handle_error;
 
 	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	error = write_image_chunk(fp, pnginfo, queue);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
@@ -1060,7 +1284,7 @@ handle_error:
 }
 
 
-png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
 	png_info pnginfo;
 	png_error error;
@@ -1081,7 +1305,7 @@ png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int
 	}
 
 	/* write the rest of the PNG data */
-	error = write_png_stream(fp, info, bitmap, palette_length, palette);
+	error = write_png_stream(fp, info, bitmap, palette_length, palette, queue);
 	if (info == &pnginfo)
 		png_free(&pnginfo);
 	return error;
@@ -1117,9 +1341,9 @@ png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate)
 	return PNGERR_NONE;
 }
 
-png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
-	return write_png_stream(fp, info, bitmap, palette_length, palette);
+	return write_png_stream(fp, info, bitmap, palette_length, palette, queue);
 }
 
 png_error mng_capture_stop(core_file *fp)
@@ -1147,17 +1147,22 @@ TILE_GET_INFO_MEMBER(goldnpkr_state::wcrdxtnd_get_bg_tile_info)
 void goldnpkr_state::video_start()
 {
 	m_bg_tilemap = &machine().tilemap().create(tilemap_get_info_delegate(FUNC(goldnpkr_state::get_bg_tile_info),this), TILEMAP_SCAN_ROWS, 8, 8, 32, 32);
+	m_bg_tilemap->set_track_changes(true);
 }
 
 VIDEO_START_MEMBER(goldnpkr_state,wcrdxtnd)
 {
 	m_bg_tilemap = &machine().tilemap().create(tilemap_get_info_delegate(FUNC(goldnpkr_state::wcrdxtnd_get_bg_tile_info),this), TILEMAP_SCAN_ROWS, 8, 8, 32, 32);
+	m_bg_tilemap->set_track_changes(true);
 }
 
 UINT32 goldnpkr_state::screen_update_goldnpkr(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
 	m_bg_tilemap->draw(screen, bitmap, cliprect, 0, 0);
-	return 0;
+
+	/* the screen is just this one tilemap and the palette is fixed, so a card
+	   table sitting idle doesn't need its texture updated */
+	return m_bg_tilemap->dirty(cliprect) ? 0 : UPDATE_HAS_NOT_CHANGED;
 }
 
 PALETTE_INIT_MEMBER(goldnpkr_state, goldnpkr)
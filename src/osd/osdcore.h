@@ -631,6 +631,19 @@ INLINE osd_work_item *osd_work_item_queue(osd_work_queue *queue, osd_work_callba
 }
 
 
+/* inline helper to run a set of work items to completion, using the calling
+   thread for the first one rather than leaving it idle in the wait; callers
+   usually keep the parameters on their stack, so this never returns early */
+INLINE void osd_work_item_run_multiple(osd_work_queue *queue, osd_work_callback callback, INT32 numitems, void *parambase, INT32 paramstep)
+{
+	if (numitems > 1)
+		osd_work_item_queue_multiple(queue, callback, numitems - 1, (UINT8 *)parambase + paramstep, paramstep, WORK_ITEM_FLAG_AUTO_RELEASE);
+	(*callback)(parambase, 0);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10))
+		;
+}
+
+
 /*-----------------------------------------------------------------------------
     osd_work_item_wait: wait for a work item to complete
 
@@ -149,6 +149,18 @@ void osd_interface::set_mastervolume(int attenuation)
 }
 
 
+//-------------------------------------------------
+//  get_audio_stats - return the state of the
+//  audio output, if available
+//-------------------------------------------------
+
+bool osd_interface::get_audio_stats(osd_audio_stats &stats)
+{
+	// buffering implementations report latency, fill level and glitches here
+	return false;
+}
+
+
 //-------------------------------------------------
 //  customize_input_type_list - provide OSD
 //  additions/modifications to the input list
@@ -29,6 +29,18 @@ class device_t;
 typedef void *osd_font;
 
 
+// ======================> osd_audio_stats
+
+// state of the audio output, for display
+struct osd_audio_stats
+{
+	int                 latency;                // most samples the output will buffer before dropping sound
+	int                 buffered;               // samples buffered right now
+	int                 underflows;             // times the output ran dry
+	int                 overflows;              // times sound was dropped because the buffer was full
+};
+
+
 // ======================> osd_interface
 
 // description of the currently-running machine
@@ -53,6 +65,7 @@ public:
 	// audio overridables
 	virtual void update_audio_stream(const INT16 *buffer, int samples_this_frame);
 	virtual void set_mastervolume(int attenuation);
+	virtual bool get_audio_stats(osd_audio_stats &stats);
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist);
@@ -73,6 +73,9 @@ struct sdl_info
 	int                 last_vofs;
 	int                 old_blitwidth;
 	int                 old_blitheight;
+
+	// queue for rasterizing large targets in parallel
+	osd_work_queue      *work_queue;
 };
 
 struct sdl_scale_mode
@@ -393,6 +396,8 @@ static int drawsdl_window_create(sdl_window_info *window, int width, int height)
 	// allocate memory for our structures
 	sdl = (sdl_info *) osd_malloc(sizeof(sdl_info));
 	memset(sdl, 0, sizeof(sdl_info));
+	if (video_config.soft_stripes)
+		sdl->work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 
 	window->dxdata = sdl;
 
@@ -574,6 +579,11 @@ static void drawsdl_window_destroy(sdl_window_info *window)
 		global_free(sdl->yuv_bitmap);
 		sdl->yuv_bitmap = NULL;
 	}
+	if (sdl->work_queue != NULL)
+	{
+		osd_work_queue_free(sdl->work_queue);
+		sdl->work_queue = NULL;
+	}
 	osd_free(sdl);
 	window->dxdata = NULL;
 }
@@ -803,23 +813,23 @@ static int drawsdl_window_draw(sdl_window_info *window, UINT32 dc, int update)
 		switch (rmask)
 		{
 			case 0x0000ff00:
-				software_renderer<UINT32, 0,0,0, 8,16,24>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 8,16,24>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4, sdl->work_queue);
 				break;
 
 			case 0x00ff0000:
-				software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4, sdl->work_queue);
 				break;
 
 			case 0x000000ff:
-				software_renderer<UINT32, 0,0,0, 0,8,16>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 0,8,16>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 4, sdl->work_queue);
 				break;
 
 			case 0xf800:
-				software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 2, sdl->work_queue);
 				break;
 
 			case 0x7c00:
-				software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*window->primlist, surfptr, mamewidth, mameheight, pitch / 2, sdl->work_queue);
 				break;
 
 			default:
@@ -831,7 +841,7 @@ static int drawsdl_window_draw(sdl_window_info *window, UINT32 dc, int update)
 	{
 		assert (sdl->yuv_bitmap != NULL);
 		assert (surfptr != NULL);
-		software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*window->primlist, sdl->yuv_bitmap, sdl->hw_scale_width, sdl->hw_scale_height, sdl->hw_scale_width);
+		software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*window->primlist, sdl->yuv_bitmap, sdl->hw_scale_width, sdl->hw_scale_height, sdl->hw_scale_width, sdl->work_queue);
 		sm->yuv_blit((UINT16 *)sdl->yuv_bitmap, sdl, surfptr, pitch);
 	}
 
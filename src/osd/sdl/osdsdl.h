@@ -61,6 +61,7 @@
 #define SDLOPTION_PRESCALE              "prescale"
 
 #define SDLOPTION_SCALEMODE             "scalemode"
+#define SDLOPTION_SOFTSTRIPES           "softstripes"
 
 #define SDLOPTION_MULTITHREADING        "multithreading"
 #define SDLOPTION_BENCH                 "bench"
@@ -167,6 +168,7 @@ public:
 	bool wait_vsync() const { return bool_value(SDLOPTION_WAITVSYNC); }
 	bool sync_refresh() const { return bool_value(SDLOPTION_SYNCREFRESH); }
 	const char *scale_mode() const { return value(SDLOPTION_SCALEMODE); }
+	bool soft_stripes() const { return bool_value(SDLOPTION_SOFTSTRIPES); }
 
 	// OpenGL specific options
 	bool filter() const { return bool_value(SDLOPTION_FILTER); }
@@ -244,6 +246,7 @@ public:
 	// audio overridables
 	virtual void update_audio_stream(const INT16 *buffer, int samples_this_frame);
 	virtual void set_mastervolume(int attenuation);
+	virtual bool get_audio_stats(osd_audio_stats &stats);
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist);
@@ -128,6 +128,7 @@ const options_entry sdl_options::s_option_entries[] =
 #else
 	{ SDLOPTION_SCALEMODE ";sm",         SDLOPTVAL_NONE,  OPTION_STRING,     "Scale mode: none, async, yv12, yuy2, yv12x2, yuy2x2 (-video soft only)" },
 #endif
+	{ SDLOPTION_SOFTSTRIPES,                  "0",        OPTION_BOOLEAN,    "draw large screens in parallel horizontal stripes (-video soft only)" },
 #if USE_OPENGL
 	// OpenGL specific options
 	{ NULL,                                   NULL,   OPTION_HEADER,  "OpenGL-SPECIFIC OPTIONS" },
@@ -198,7 +199,7 @@ const options_entry sdl_options::s_option_entries[] =
 
 	// sound options
 	{ NULL,                                   NULL,  OPTION_HEADER,     "SOUND OPTIONS" },
-	{ SDLOPTION_AUDIO_LATENCY,                "2",   OPTION_INTEGER,    "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
+	{ SDLOPTION_AUDIO_LATENCY,                "2",   OPTION_INTEGER,    "set the most audio latency, in fifths of a second (increase to reduce glitches, decrease for responsiveness)" },
 
 	// keyboard mapping
 	{ NULL,                                   NULL,  OPTION_HEADER,     "SDL KEYBOARD MAPPING" },
@@ -34,11 +34,13 @@
 
 static int sdl_xfer_samples = SDL_XFER_SAMPLES;
 static int stream_in_initialized = 0;
-static int stream_loop = 0;
 
 // maximum audio latency
 #define MAX_AUDIO_LATENCY       5
 
+// seconds without an underflow before the target latency is lowered
+#define LATENCY_SHRINK_SECONDS  10
+
 //============================================================
 //  LOCAL VARIABLES
 //============================================================
@@ -46,16 +48,29 @@ static int stream_loop = 0;
 static int              attenuation = 0;
 
 static int              initialized_audio = 0;
-static int              buf_locked;
 
+// the stream buffer is a single-producer, single-consumer ring: only the
+// emulation thread moves the write position and only the SDL callback moves
+// the play position, so neither side needs a lock
 static INT8             *stream_buffer;
-static volatile INT32   stream_playpos;
-
 static UINT32           stream_buffer_size;
-static UINT32           stream_buffer_in;
-
-// buffer over/underflow counts
-static int              buffer_underflows;
+static volatile INT32   stream_playpos;
+static volatile INT32   stream_writepos;
+
+// adaptive latency: the most bytes left buffered after an update before the
+// oldest sound is dropped
+static INT32            stream_target;
+static INT32            stream_target_min;
+static INT32            stream_target_max;
+static osd_ticks_t      stream_calm_start;
+static INT32            stream_last_underflows;
+
+// set while the machine is paused and no updates arrive; cleared by the
+// first update after it resumes
+static volatile INT32   stream_paused;
+
+// buffer over/underflow counts; underflows are counted by the callback
+static volatile INT32   buffer_underflows;
 static int              buffer_overflows;
 
 // debugging
@@ -74,6 +89,7 @@ static void         sdl_kill(running_machine &machine);
 static int          sdl_create_buffers(void);
 static void         sdl_destroy_buffers(void);
 static void         sdl_cleanup_audio(running_machine &machine);
+static void         sdl_pause_audio(running_machine &machine);
 static void         SDLCALL sdl_callback(void *userdata, Uint8 *stream, int len);
 
 
@@ -93,6 +109,7 @@ void sdlaudio_init(running_machine &machine)
 		if (sdl_init(machine))
 			return;
 
+		machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(FUNC(sdl_pause_audio), &machine));
 		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(sdl_cleanup_audio), &machine));
 		// set the startup volume
 		machine.osd().set_mastervolume(attenuation);
@@ -102,6 +119,19 @@ void sdlaudio_init(running_machine &machine)
 
 
 
+//============================================================
+//  sdl_pause_audio - note that updates will
+//  stop until the machine resumes, so the
+//  callback running dry is expected
+//============================================================
+
+static void sdl_pause_audio(running_machine &machine)
+{
+	atomic_exchange32(&stream_paused, 1);
+}
+
+
+
 //============================================================
 //  osd_stop_audio_stream
 //============================================================
@@ -119,6 +149,7 @@ static void sdl_cleanup_audio(running_machine &machine)
 	// print out over/underflow stats
 	if (buffer_overflows || buffer_underflows)
 		mame_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+	mame_printf_verbose("Sound buffer: final latency %d samples\n", (int)(stream_target / (2 * sizeof(INT16))));
 
 	if (LOG_SOUND)
 	{
@@ -128,69 +159,25 @@ static void sdl_cleanup_audio(running_machine &machine)
 }
 
 //============================================================
-//  lock_buffer
+//  ring_load - read a position owned by the
+//  other side of the ring; the atomic add acts
+//  as a full barrier, so data published before
+//  the position is visible after it
 //============================================================
-static int lock_buffer(running_machine &machine, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2)
-{
-	volatile long pstart, pend, lstart, lend;
-
-	if (!buf_locked)
-	{
-		if (machine.video().throttled())
-		{
-			pstart = stream_playpos;
-			pend = (pstart + sdl_xfer_samples);
-			lstart = offset;
-			lend = lstart+size;
-			while (((pstart >= lstart) && (pstart <= lend)) ||
-					((pend >= lstart) && (pend <= lend)))
-			{
-				pstart = stream_playpos;
-				pend = pstart + sdl_xfer_samples;
-			}
-		}
-
-		SDL_LockAudio();
-		buf_locked++;
-	}
-
-	// init lengths
-	*length1 = *length2 = 0;
-
-	if ((offset + size) > stream_buffer_size)
-	{
-		// 2-piece case
-		*length1 = stream_buffer_size - offset;
-		*buffer1 = &stream_buffer[offset];
-		*length2 = size - *length1;
-		*buffer2 = stream_buffer;
-	}
-	else
-	{
-		// normal 1-piece case
-		*length1 = size;
-		*buffer1 = &stream_buffer[offset];
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking %ld bytes at offset %ld (total %d, playpos %d): len1 %ld len2 %ld\n",
-			size, offset, stream_buffer_size, stream_playpos, *length1, *length2);
 
-	return 0;
+INLINE INT32 ring_load(INT32 volatile *pos)
+{
+	return atomic_add32(pos, 0);
 }
 
 //============================================================
-//  unlock_buffer
+//  ring_fill - return the number of bytes
+//  between the given play and write positions
 //============================================================
-static void unlock_buffer(void)
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
 
+INLINE INT32 ring_fill(INT32 playpos, INT32 writepos)
+{
+	return (writepos >= playpos) ? (writepos - playpos) : (writepos + stream_buffer_size - playpos);
 }
 
 //============================================================
@@ -210,50 +197,66 @@ static void att_memcpy(void *dest, const INT16 *data, int bytes_to_copy)
 }
 
 //============================================================
-//  copy_sample_data
+//  ring_write - copy data (or silence, if data
+//  is NULL) in at the write position and
+//  publish it to the callback
 //============================================================
 
-static void copy_sample_data(running_machine &machine, const INT16 *data, int bytes_to_copy)
+static void ring_write(const INT16 *data, int bytes_to_copy)
 {
-	void *buffer1, *buffer2 = (void *)NULL;
-	long length1, length2;
-	int cur_bytes;
-
-	// attempt to lock the stream buffer
-	if (lock_buffer(machine, stream_buffer_in, bytes_to_copy, &buffer1, &length1, &buffer2, &length2) < 0)
-	{
-		buffer_underflows++;
-		return;
-	}
+	INT32 writepos = stream_writepos;
 
-	// adjust the input pointer
-	stream_buffer_in += bytes_to_copy;
-	if (stream_buffer_in >= stream_buffer_size)
+	while (bytes_to_copy > 0)
 	{
-		stream_buffer_in -= stream_buffer_size;
-		stream_loop = 1;
+		// copy up to the end of the buffer at most
+		int cur_bytes = MIN(bytes_to_copy, (int)stream_buffer_size - writepos);
+		if (data != NULL)
+		{
+			att_memcpy(&stream_buffer[writepos], data, cur_bytes);
+			data = (const INT16 *)((const UINT8 *)data + cur_bytes);
+		}
+		else
+			memset(&stream_buffer[writepos], 0, cur_bytes);
 
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 1 (stream_buffer_in looped)\n");
+		bytes_to_copy -= cur_bytes;
+		writepos += cur_bytes;
+		if (writepos >= (INT32)stream_buffer_size)
+			writepos = 0;
 	}
 
-	// copy the first chunk
-	cur_bytes = (bytes_to_copy > length1) ? length1 : bytes_to_copy;
-	att_memcpy(buffer1, data, cur_bytes);
+	// only now let the callback see the data
+	atomic_exchange32(&stream_writepos, writepos);
+}
 
-	// adjust for the number of bytes
-	bytes_to_copy -= cur_bytes;
-	data = (INT16 *)((UINT8 *)data + cur_bytes);
+//============================================================
+//  adjust_latency - raise the target latency
+//  whenever the callback has run dry since the
+//  last update, and lower it again slowly once
+//  things have been quiet for a while
+//============================================================
+
+static void adjust_latency(INT32 underflows)
+{
+	osd_ticks_t now = osd_ticks();
+	INT32 xfer_bytes = sdl_xfer_samples * 2 * sizeof(INT16);
 
-	// copy the second chunk
-	if (bytes_to_copy != 0)
+	if (underflows != stream_last_underflows)
 	{
-		cur_bytes = (bytes_to_copy > length2) ? length2 : bytes_to_copy;
-		att_memcpy(buffer2, data, cur_bytes);
+		stream_last_underflows = underflows;
+		stream_target = MIN(stream_target + xfer_bytes, stream_target_max);
+		stream_calm_start = now;
+
+		if (LOG_SOUND)
+			fprintf(sound_log, "Underflow: target raised to %d\n", (int)stream_target);
 	}
+	else if (now - stream_calm_start > osd_ticks_per_second() * LATENCY_SHRINK_SECONDS)
+	{
+		stream_target = MAX(stream_target - (xfer_bytes / 4 & ~3), stream_target_min);
+		stream_calm_start = now;
 
-	// unlock
-	unlock_buffer();
+		if (LOG_SOUND)
+			fprintf(sound_log, "Quiet: target lowered to %d\n", (int)stream_target);
+	}
 }
 
 
@@ -267,73 +270,63 @@ void sdl_osd_interface::update_audio_stream(const INT16 *buffer, int samples_thi
 	if (machine().sample_rate() != 0 && stream_buffer)
 	{
 		int bytes_this_frame = samples_this_frame * sizeof(INT16) * 2;
-		int play_position, write_position, stream_in;
-		int orig_write; // used in LOG
-
-		play_position = stream_playpos;
-
-		write_position = stream_playpos + ((machine().sample_rate() / 50) * sizeof(INT16) * 2);
-		orig_write = write_position;
+		INT32 fill = ring_fill(ring_load(&stream_playpos), stream_writepos);
 
-		if (!stream_in_initialized)
+		// track the callback's underflows; the silence it played in their place
+		// has already added to the latency, so just allow for that from now on
+		INT32 underflows = ring_load(&buffer_underflows);
+		bool resuming = (ring_load(&stream_paused) != 0);
+		if (resuming)
 		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
-
-			if (LOG_SOUND)
-			{
-				fprintf(sound_log, "stream_in = %d\n", (int)stream_in);
-				fprintf(sound_log, "stream_playpos = %d\n", (int)stream_playpos);
-				fprintf(sound_log, "write_position = %d\n", (int)write_position);
-			}
-			// start playing
-			SDL_PauseAudio(0);
-
-			stream_in_initialized = 1;
+			// the buffer drained while we were paused; start over from here
+			// without touching the target
+			stream_last_underflows = underflows;
+			stream_calm_start = osd_ticks();
 		}
-		else
-		{
-			// normalize the stream in position
-			stream_in = stream_buffer_in;
-			if (stream_in < write_position && stream_loop == 1)
-				stream_in += stream_buffer_size;
-
-			// now we should have, in order:
-			//    <------pp---wp---si--------------->
+		else if (stream_in_initialized)
+			adjust_latency(underflows);
 
-			// if we're between play and write positions, then bump forward, but only in full chunks
-			while (stream_in < write_position)
+		// prime the buffer with silence the first time through and after a pause
+		if (!stream_in_initialized || resuming)
+		{
+			INT32 padding = stream_target - fill - bytes_this_frame;
+			if (padding > 0)
 			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_underflows++;
-				stream_in += bytes_this_frame;
+				ring_write(NULL, padding);
+				fill += padding;
 			}
 
-			// if we're going to overlap the play position, just skip this chunk
-			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_overflows++;
-				return;
-			}
+			// the buffer is full again, so let the callback count underflows
+			if (resuming)
+				atomic_exchange32(&stream_paused, 0);
 		}
 
-		if (stream_in >= stream_buffer_size)
+		// if we'd end up more than a frame beyond the target, drop the oldest
+		// part of this frame; never let the write position catch the play position
+		INT32 limit = MIN(stream_target + bytes_this_frame, (INT32)stream_buffer_size - 4);
+		if (fill + bytes_this_frame > limit)
 		{
-			stream_in -= stream_buffer_size;
-			stream_loop = 1;
-
+			INT32 skip = fill + bytes_this_frame - limit;
 			if (LOG_SOUND)
-				fprintf(sound_log, "stream_loop set to 1 (stream_in looped)\n");
+				fprintf(sound_log, "Overflow: fill=%d BTF=%d skip=%d\n", (int)fill, bytes_this_frame, (int)skip);
 
+			buffer_overflows++;
+			if (skip >= bytes_this_frame)
+				return;
+			buffer = (const INT16 *)((const UINT8 *)buffer + skip);
+			bytes_this_frame -= skip;
 		}
 
 		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in;
-		copy_sample_data(machine(), buffer, bytes_this_frame);
+		ring_write(buffer, bytes_this_frame);
+
+		// start playing once the buffer has been primed
+		if (!stream_in_initialized)
+		{
+			stream_calm_start = osd_ticks();
+			SDL_PauseAudio(0);
+			stream_in_initialized = 1;
+		}
 	}
 }
 
@@ -354,65 +347,63 @@ void sdl_osd_interface::set_mastervolume(int _attenuation)
 	attenuation = _attenuation;
 }
 
+//============================================================
+//  get_audio_stats
+//============================================================
+
+bool sdl_osd_interface::get_audio_stats(osd_audio_stats &stats)
+{
+	if (!stream_in_initialized || stream_buffer == NULL)
+		return false;
+
+	stats.latency = stream_target / (2 * sizeof(INT16));
+	stats.buffered = ring_fill(stream_playpos, stream_writepos) / (2 * sizeof(INT16));
+	stats.underflows = buffer_underflows;
+	stats.overflows = buffer_overflows;
+	return true;
+}
+
 //============================================================
 //  sdl_callback
 //============================================================
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
-	int len1, len2, sb_in;
-
-	sb_in = stream_buffer_in;
-	if (stream_loop)
-		sb_in += stream_buffer_size;
+	INT32 playpos = stream_playpos;
+	INT32 fill = ring_fill(playpos, ring_load(&stream_writepos));
+	int avail = MIN(fill, len);
 
-	if (sb_in < (stream_playpos+len))
+	// play whatever we have; if that's not enough, pad with silence and note it,
+	// unless the machine is paused and nothing more is coming
+	if (avail < len)
 	{
 		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)stream_playpos, (int)sb_in, (int)stream_buffer_in, (int)len);
+			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d fill=%d Len=%d\n", (int)playpos, (int)fill, (int)len);
 
-		return;
-	}
-	else if ((stream_playpos+len) > stream_buffer_size)
-	{
-		len1 = stream_buffer_size - stream_playpos;
-		len2 = len - len1;
-	}
-	else
-	{
-		len1 = len;
-		len2 = 0;
+		memset(stream + avail, 0, len - avail);
+		if (ring_load(&stream_paused) == 0)
+			atomic_add32(&buffer_underflows, 1);
 	}
 
-	if (snd_enabled)
+	for (int done = 0; done < avail; )
 	{
-		memcpy(stream, stream_buffer + stream_playpos, len1);
-		memset(stream_buffer + stream_playpos, 0, len1); // no longer needed
-		if (len2)
-		{
-			memcpy(stream+len1, stream_buffer, len2);
-			memset(stream_buffer, 0, len2); // no longer needed
-		}
+		// copy up to the end of the buffer at most
+		int cur_bytes = MIN(avail - done, (int)stream_buffer_size - playpos);
+		if (snd_enabled)
+			memcpy(stream + done, stream_buffer + playpos, cur_bytes);
+		else
+			memset(stream + done, 0, cur_bytes);
 
-	}
-	else
-	{
-		memset(stream, 0, len);
+		done += cur_bytes;
+		playpos += cur_bytes;
+		if (playpos >= (INT32)stream_buffer_size)
+			playpos = 0;
 	}
 
-	// move the play cursor
-	stream_playpos += len1 + len2;
-	if (stream_playpos >= stream_buffer_size)
-	{
-		stream_playpos -= stream_buffer_size;
-		stream_loop = 0;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 0 (stream_playpos looped)\n");
-	}
+	// move the play cursor, handing the space back to the emulation thread
+	atomic_exchange32(&stream_playpos, playpos);
 
 	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer len1 %d len2 %d, playpos %d\n",
-				len1, len2, stream_playpos);
+		fprintf(sound_log, "callback: xfer %d, playpos %d\n", avail, playpos);
 }
 
 
@@ -423,6 +414,7 @@ static int sdl_init(running_machine &machine)
 {
 	int         n_channels = 2;
 	int         audio_latency;
+	INT32       update_bytes, xfer_bytes;
 	SDL_AudioSpec   aspec, obtained;
 	char audio_driver[16] = "";
 
@@ -443,7 +435,6 @@ static int sdl_init(running_machine &machine)
 
 	sdl_xfer_samples = SDL_XFER_SAMPLES;
 	stream_in_initialized = 0;
-	stream_loop = 0;
 
 	// set up the audio specs
 	aspec.freq = machine.sample_rate();
@@ -476,12 +467,25 @@ static int sdl_init(running_machine &machine)
 		audio_latency = 1;
 	}
 
-	// compute the buffer sizes
+	// compute the buffer sizes; the audio latency sets how far the target may grow
 	stream_buffer_size = machine.sample_rate() * 2 * sizeof(INT16) * audio_latency / MAX_AUDIO_LATENCY;
 	stream_buffer_size = (stream_buffer_size / 1024) * 1024;
 	if (stream_buffer_size < 1024)
 		stream_buffer_size = 1024;
 
+	// the target must cover one sound update plus one callback's worth, and the
+	// buffer must hold at least twice that plus another update
+	update_bytes = (machine.sample_rate() / sound_manager::STREAMS_UPDATE_FREQUENCY) * 2 * sizeof(INT16);
+	xfer_bytes = sdl_xfer_samples * 2 * sizeof(INT16);
+	stream_target_min = update_bytes + xfer_bytes;
+	if ((INT32)stream_buffer_size < 2 * (stream_target_min + update_bytes))
+		stream_buffer_size = (2 * (stream_target_min + update_bytes) + 1023) / 1024 * 1024;
+	stream_target_max = stream_buffer_size - update_bytes - 4;
+
+	// start with one callback of headroom and adapt from there
+	stream_target = MIN(stream_target_min + xfer_bytes, stream_target_max);
+	mame_printf_verbose("Audio: latency %d samples, at most %d\n", (int)(stream_target / (2 * sizeof(INT16))), (int)(stream_target_max / (2 * sizeof(INT16))));
+
 	// create the buffers
 	if (sdl_create_buffers())
 		goto cant_create_buffers;
@@ -525,7 +529,11 @@ static int sdl_create_buffers(void)
 
 	stream_buffer = global_alloc_array_clear(INT8, stream_buffer_size);
 	stream_playpos = 0;
-	buf_locked = 0;
+	stream_writepos = 0;
+	buffer_underflows = 0;
+	buffer_overflows = 0;
+	stream_last_underflows = 0;
+	stream_paused = 0;
 	return 0;
 }
 
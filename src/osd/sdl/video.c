@@ -795,6 +795,9 @@ static void extract_video_config(running_machine &machine)
 		mame_printf_warning("scalemode is only for -video soft, overriding\n");
 		video_config.scale_mode = VIDEO_SCALE_MODE_NONE;
 	}
+
+	// software rendering settings ...
+	video_config.soft_stripes = options.soft_stripes();
 }
 
 
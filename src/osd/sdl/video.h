@@ -132,6 +132,9 @@ struct sdl_video_config
 
 	// YUV options
 	int                 scale_mode;
+
+	// software rendering options
+	int                 soft_stripes;   // rasterize large targets on several threads
 };
 
 //============================================================
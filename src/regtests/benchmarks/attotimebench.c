@@ -0,0 +1,112 @@
+/***************************************************************************
+
+    attotimebench.c
+
+    Benchmark of attotime scaling: multiplication, division and tick
+    conversion, as done by src/emu/attotime.c.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "osdcore.h"
+#include "eminline.h"
+#include "attotime.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define INPUT_COUNT     4096
+#define PASSES          500
+
+/* this file is also built against attotime.c with ATTOTIME_WIDE_MATH=0 */
+#if defined(ATTOTIME_WIDE_MATH) && !ATTOTIME_WIDE_MATH
+#define MATH_NAME       "64x32 divide chain"
+#else
+#define MATH_NAME       "default"
+#endif
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static attotime times[INPUT_COUNT];
+static UINT32 factors[INPUT_COUNT];
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    make_inputs - sub-second periods as produced
+    by CPU and sound clocks, plus some times of
+    several seconds; small and large factors
+-------------------------------------------------*/
+
+static void make_inputs()
+{
+	srand(1);
+	for (int index = 0; index < INPUT_COUNT; index++)
+	{
+		UINT32 clock = 1000 + rand() % 50000000;
+		times[index] = attotime::from_hz(clock) * (1 + rand() % 64);
+		if (index % 8 == 0)
+			times[index] += attotime::from_seconds(rand() % 100);
+		factors[index] = (index % 2) ? (1 + rand() % 1000) : (1 + rand());
+	}
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	make_inputs();
+
+	// the checksums must match between builds
+	UINT64 mulsum = 0, divsum = 0, tickssum = 0;
+	osd_ticks_t multime = 0, divtime = 0, tickstime = 0;
+	for (int pass = 0; pass < PASSES; pass++)
+	{
+		osd_ticks_t start = osd_ticks();
+		for (int index = 0; index < INPUT_COUNT; index++)
+		{
+			attotime result = times[index] * factors[index];
+			mulsum += result.seconds + result.attoseconds;
+		}
+		multime += osd_ticks() - start;
+
+		start = osd_ticks();
+		for (int index = 0; index < INPUT_COUNT; index++)
+		{
+			attotime result = times[index] / factors[index];
+			divsum += result.seconds + result.attoseconds;
+		}
+		divtime += osd_ticks() - start;
+
+		start = osd_ticks();
+		for (int index = 0; index < INPUT_COUNT; index++)
+			tickssum += times[index].as_ticks(factors[index]);
+		tickstime += osd_ticks() - start;
+	}
+
+	double scale = 1e9 / ((double)osd_ticks_per_second() * INPUT_COUNT * PASSES);
+	printf("attotime scaling (%s):\n", MATH_NAME);
+	printf("operator*  %6.2f ns  checksum %016" I64FMT "x\n", (double)multime * scale, mulsum);
+	printf("operator/  %6.2f ns  checksum %016" I64FMT "x\n", (double)divtime * scale, divsum);
+	printf("as_ticks   %6.2f ns  checksum %016" I64FMT "x\n", (double)tickstime * scale, tickssum);
+	return 0;
+}
@@ -0,0 +1,239 @@
+/***************************************************************************
+
+    resamplebench.c
+
+    Benchmark of the stream resamplers: the fast point sample/average
+    conversion against the polyphase windowed-sinc filters, both for
+    speed and for how cleanly they pass a test tone.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "emucore.h"
+#include "emutempl.h"
+#include "eminline.h"
+#include "attotime.h"
+#include "resample.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* 48kHz output in 20ms stream updates */
+static const UINT32 OUTPUT_RATE = 48000;
+static const int UPDATES_PER_SECOND = 50;
+static const int SAMPLES_PER_UPDATE = OUTPUT_RATE / UPDATES_PER_SECOND;
+static const int SECONDS = 8;
+static const int UPDATES = SECONDS * UPDATES_PER_SECOND;
+
+/* source samples kept ahead of the first one converted */
+static const int PREROLL = 1024;
+
+/* rates typical of emulated sound chips; each is used twice, once with a
+   midrange tone and once with a tone near the output Nyquist frequency */
+static const UINT32 source_rates[] =
+{
+	55930, 223721, 22050, 44100, 31250, 18432, 8000, 96000,
+	62500, 111860, 15625, 27965, 250000, 40000, 32000, 11025
+};
+static const int STREAMS = 2 * ARRAY_LENGTH(source_rates);
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct bench_stream
+{
+	UINT32      rate;           /* source sample rate */
+	INT64       period;         /* attoseconds per source sample */
+	double      frequency;      /* test tone */
+	INT32 *     buffer;         /* source samples, PREROLL ahead of time 0 */
+	INT64       fast_latency;   /* input latency with the fast resampler */
+	INT64       sinc_latency;   /* input latency with a filter */
+	resample_filter *filter;    /* shared filter, or NULL for the fast path */
+};
+
+
+
+/***************************************************************************
+    RESAMPLERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    resample - convert one update of a stream to
+    the output rate with the kernels in
+    src/emu/resample.c, positioned as
+    sound_stream::generate_resampled_data does
+-------------------------------------------------*/
+
+static void resample(const bench_stream &stream, bool sinc, int outindex, INT32 *dest, int numsamples)
+{
+	const resample_filter *filter = sinc ? stream.filter : NULL;
+	INT64 outperiod = ATTOSECONDS_PER_SECOND / OUTPUT_RATE;
+	INT64 basetime = outindex * outperiod - ((filter != NULL) ? stream.sinc_latency : stream.fast_latency);
+	INT32 basesample = (basetime >= 0) ? basetime / stream.period : -(-basetime / stream.period) - 1;
+	const INT32 *source = &stream.buffer[PREROLL + basesample];
+	UINT32 basefrac = (basetime - basesample * stream.period) / ((stream.period + RESAMPLE_FRAC_ONE - 1) >> RESAMPLE_FRAC_BITS);
+	UINT32 step = (UINT64(stream.rate) << RESAMPLE_FRAC_BITS) / OUTPUT_RATE;
+
+	if (filter != NULL)
+		filter->resample(dest, source, basefrac, step, 0x100, numsamples);
+	else
+		resample_fast(dest, source, basefrac, step, 0x100, numsamples);
+}
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    init_stream - generate the test tone and pick
+    the resampler setup the stream would get
+-------------------------------------------------*/
+
+static void init_stream(bench_stream &stream, int index)
+{
+	stream.rate = source_rates[index % ARRAY_LENGTH(source_rates)];
+	stream.period = ATTOSECONDS_PER_SECOND / stream.rate;
+
+	// the second set of tones sits near the output Nyquist frequency, where
+	// the fast resampler aliases the most
+	double limit = MIN(stream.rate, OUTPUT_RATE);
+	if (index < ARRAY_LENGTH(source_rates))
+	{
+		stream.frequency = 440.0 * pow(1.5, index % 9);
+		if (stream.frequency > 0.45 * limit)
+			stream.frequency = 0.3 * limit;
+	}
+	else
+		stream.frequency = 0.4 * limit;
+
+	int count = SECONDS * stream.rate + 4 * PREROLL;
+	stream.buffer = new INT32[count];
+	for (int sample = 0; sample < count; sample++)
+		stream.buffer[sample] = INT32(floor(10000.0 * sin(2 * M_PI * stream.frequency * double(sample - PREROLL) / stream.rate) + 0.5));
+
+	// latencies as computed by sound_stream::recompute_sample_rate_data
+	INT64 outperiod = ATTOSECONDS_PER_SECOND / OUTPUT_RATE;
+	stream.fast_latency = MAX(stream.period, outperiod);
+	if (stream.rate < OUTPUT_RATE)
+		stream.fast_latency += stream.period;
+
+	stream.filter = NULL;
+	if (resample_filter::usable(stream.rate, OUTPUT_RATE))
+	{
+		stream.filter = new resample_filter(stream.rate, OUTPUT_RATE);
+		stream.sinc_latency = (stream.filter->half_taps() + 1) * stream.period + outperiod;
+	}
+}
+
+
+/*-------------------------------------------------
+    tone_snr - fit a sine at the known frequency
+    by least squares and return the ratio of it to
+    everything else, in dB
+-------------------------------------------------*/
+
+static double tone_snr(const bench_stream &stream, const INT32 *output)
+{
+	double w = 2 * M_PI * stream.frequency / OUTPUT_RATE;
+	double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+
+	// skip the first updates, which are still ramping in from the preroll
+	int first = 2 * SAMPLES_PER_UPDATE, last = (UPDATES - 1) * SAMPLES_PER_UPDATE;
+	for (int n = first; n < last; n++)
+	{
+		double a = sin(w * n), b = cos(w * n);
+		ss += a * a;
+		sc += a * b;
+		cc += b * b;
+		ys += output[n] * a;
+		yc += output[n] * b;
+	}
+	double det = ss * cc - sc * sc;
+	double sinamp = (ys * cc - yc * sc) / det;
+	double cosamp = (yc * ss - ys * sc) / det;
+
+	double signal = 0, error = 0;
+	for (int n = first; n < last; n++)
+	{
+		double fit = sinamp * sin(w * n) + cosamp * cos(w * n);
+		signal += fit * fit;
+		error += (output[n] - fit) * (output[n] - fit);
+	}
+	return 10 * log10(signal / error);
+}
+
+
+/*-------------------------------------------------
+    run - convert every stream one update at a
+    time, as the sound manager does; returns
+    milliseconds per emulated second
+-------------------------------------------------*/
+
+static double run(bench_stream *streams, bool sinc, INT32 *output)
+{
+	osd_ticks_t start = osd_ticks();
+	for (int update = 1; update < UPDATES - 1; update++)
+		for (int index = 0; index < STREAMS; index++)
+			resample(streams[index], sinc, update * SAMPLES_PER_UPDATE, &output[(index * UPDATES + update) * SAMPLES_PER_UPDATE], SAMPLES_PER_UPDATE);
+	osd_ticks_t elapsed = osd_ticks() - start;
+
+	double seconds = double(UPDATES - 2) / UPDATES_PER_SECOND;
+	return (double)elapsed * 1000.0 / (double)osd_ticks_per_second() / seconds;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+	bench_stream *streams = new bench_stream[STREAMS];
+	for (int index = 0; index < STREAMS; index++)
+		init_stream(streams[index], index);
+	INT32 *output = new INT32[STREAMS * UPDATES * SAMPLES_PER_UPDATE];
+
+	printf("Resampling %d streams to %dHz:\n", STREAMS, OUTPUT_RATE);
+	for (int mode = 0; mode < 2; mode++)
+	{
+		bool sinc = (mode == 1);
+		double msec = run(streams, sinc, output);
+
+		double worst = 1e9, total = 0;
+		for (int index = 0; index < STREAMS; index++)
+		{
+			const bench_stream &stream = streams[index];
+			double snr = tone_snr(stream, &output[index * UPDATES * SAMPLES_PER_UPDATE]);
+			if (verbose)
+				printf("  %6dHz source, %7.1fHz tone: %5.1fdB%s\n", stream.rate, stream.frequency, snr, (sinc && stream.filter == NULL) ? " (fast)" : "");
+			worst = MIN(worst, snr);
+			total += snr;
+		}
+		printf("%s: %6.2f ms per emulated second  SNR mean %5.1fdB  worst %5.1fdB\n", sinc ? "sinc" : "fast", msec, total / STREAMS, worst);
+	}
+
+	for (int index = 0; index < STREAMS; index++)
+	{
+		delete[] streams[index].buffer;
+		delete streams[index].filter;
+	}
+	delete[] streams;
+	delete[] output;
+	return 0;
+}
@@ -0,0 +1,185 @@
+/***************************************************************************
+
+    timerbench.c
+
+    Benchmark of the scheduler's timer expiration queue against the
+    sorted list it replaced.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "osdcore.h"
+#include "coretmpl.h"
+#include "eminline.h"
+#include "attotime.h"
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* the parts of emu_timer that the queues look at; the heap ordering is
+   the same as emu_timer::heap_before in src/emu/schedule.h */
+class bench_timer
+{
+public:
+	bench_timer() : next(NULL), prev(NULL), m_heap_index(-1), sequence(0) { }
+
+	bool heap_before(const bench_timer &other) const { return (expire < other.expire || (expire == other.expire && sequence < other.sequence)); }
+
+	bench_timer *next;          /* sorted list links */
+	bench_timer *prev;
+	int         m_heap_index;   /* heap position */
+	UINT64      sequence;       /* heap tie-breaker */
+	attotime    expire;
+	attotime    period;
+};
+
+
+
+/***************************************************************************
+    SORTED LIST (THE OLD QUEUE)
+***************************************************************************/
+
+/* the insertion sort that device_scheduler used before the heap */
+class timer_list
+{
+public:
+	timer_list() : m_head(NULL) { }
+
+	bench_timer &head() const { return *m_head; }
+
+	void insert(bench_timer &timer)
+	{
+		// timers expiring together stay in insertion order
+		bench_timer *prev = NULL;
+		bench_timer *cur;
+		for (cur = m_head; cur != NULL; prev = cur, cur = cur->next)
+			if (timer.expire < cur->expire)
+				break;
+		timer.prev = prev;
+		timer.next = cur;
+		if (prev != NULL)
+			prev->next = &timer;
+		else
+			m_head = &timer;
+		if (cur != NULL)
+			cur->prev = &timer;
+	}
+
+	void update(bench_timer &timer)
+	{
+		if (timer.prev != NULL)
+			timer.prev->next = timer.next;
+		else
+			m_head = timer.next;
+		if (timer.next != NULL)
+			timer.next->prev = timer.prev;
+		insert(timer);
+	}
+
+private:
+	bench_timer *m_head;
+};
+
+
+
+/***************************************************************************
+    BINARY HEAP (THE NEW QUEUE)
+***************************************************************************/
+
+/* indexed_heap from coretmpl.h, numbered the way
+   device_scheduler::timer_queue_update does it */
+class timer_heap
+{
+public:
+	timer_heap() : m_sequence(0) { }
+
+	bench_timer &head() const { return m_heap.head(); }
+
+	void insert(bench_timer &timer) { update(timer); }
+
+	void update(bench_timer &timer)
+	{
+		timer.sequence = m_sequence++;
+		m_heap.update(timer);
+	}
+
+private:
+	indexed_heap<bench_timer> m_heap;
+	UINT64      m_sequence;
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    run - fire the head timer and rearm it one
+    period later, the way periodic timers are
+    handled by execute_timers; returns millions of
+    operations per second
+-------------------------------------------------*/
+
+template<class _Queue>
+static double run(int count, int operations, UINT64 &checksum)
+{
+	bench_timer *timers = new bench_timer[count];
+	_Queue *queue = new _Queue;
+
+	// periods between 1 and 100us, as typical of CPU and sound timers
+	srand(1);
+	for (int index = 0; index < count; index++)
+	{
+		bench_timer &timer = timers[index];
+		timer.period = attotime(0, (attoseconds_t)(1000 + rand() % 100000) * 1000000);
+		timer.expire = timer.period;
+		queue->insert(timer);
+	}
+
+	osd_ticks_t start = osd_ticks();
+	for (int op = 0; op < operations; op++)
+	{
+		bench_timer &timer = queue->head();
+		checksum += timer.expire.attoseconds;
+		timer.expire += timer.period;
+		queue->update(timer);
+	}
+	osd_ticks_t elapsed = osd_ticks() - start;
+
+	delete queue;
+	delete[] timers;
+	return (double)operations * (double)osd_ticks_per_second() / (double)elapsed / 1000000.0;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	static const int counts[] = { 10, 30, 100, 300, 1000 };
+
+	printf("Timer queue operations (fire head, rearm one period later):\n");
+	for (int index = 0; index < ARRAY_LENGTH(counts); index++)
+	{
+		// the list is quadratic, so give the larger sizes fewer operations
+		int count = counts[index];
+		int operations = (count >= 300) ? 1000000 : 10000000;
+
+		// both queues must fire the same timers in the same order
+		UINT64 listsum = 0, heapsum = 0;
+		double list = run<timer_list>(count, operations, listsum);
+		double heap = run<timer_heap>(count, operations, heapsum);
+		printf("%5d timers: list %6.2f Mop/s  heap %6.2f Mop/s%s\n", count, list, heap, (listsum == heapsum) ? "" : "  (MISMATCH)");
+	}
+	return 0;
+}
@@ -65,3 +65,50 @@ jedutiltest:
 chdmantest:
 	@echo Running chdman unittest
 	$(PYTHON) $(SRC)/regtests/chdman/chdtest.py
+
+
+
+#-------------------------------------------------
+# benchmarks; built and run by "make benchmarks",
+# they are not part of the regression tests
+#-------------------------------------------------
+
+BENCHSRC = $(SRC)/regtests/benchmarks
+BENCHOBJ = $(OBJ)/regtests/benchmarks
+
+OBJDIRS += \
+	$(BENCHOBJ) \
+
+BENCHMARKS += \
+	timerbench$(EXE) \
+	resamplebench$(EXE) \
+	attotimebench$(EXE) \
+	attotimebench_chain$(EXE) \
+
+benchmarks: maketree $(BENCHMARKS)
+	@for bench in $(BENCHMARKS); do ./$$bench || exit 1; done
+
+timerbench$(EXE): $(BENCHOBJ)/timerbench.o $(EMUOBJ)/attotime.o $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+resamplebench$(EXE): $(BENCHOBJ)/resamplebench.o $(EMUOBJ)/resample.o $(EMUOBJ)/emualloc.o $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+attotimebench$(EXE): $(BENCHOBJ)/attotimebench.o $(EMUOBJ)/attotime.o $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+# the same benchmark against attotime.c built without the 128-bit path
+attotimebench_chain$(EXE): $(BENCHOBJ)/attotimebench_chain.o $(BENCHOBJ)/attotime_chain.o $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+$(BENCHOBJ)/attotimebench_chain.o: $(BENCHSRC)/attotimebench.c | $(OSPREBUILD)
+	@echo Compiling $< with ATTOTIME_WIDE_MATH=0...
+	$(CC) $(CDEFS) $(CFLAGS) -DATTOTIME_WIDE_MATH=0 -c $< -o $@
+
+$(BENCHOBJ)/attotime_chain.o: $(EMUSRC)/attotime.c | $(OSPREBUILD)
+	@echo Compiling $< with ATTOTIME_WIDE_MATH=0...
+	$(CC) $(CDEFS) $(CFLAGS) -DATTOTIME_WIDE_MATH=0 -c $< -o $@
@@ -0,0 +1,237 @@
+/***************************************************************************
+
+    mfvdecode.c
+
+    Decoder for the lossless movies written by -mfvwrite.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "corefile.h"
+#include "astring.h"
+#include "mfvio.h"
+#include "png.h"
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    put_32bits - write 32 bits in LSB order
+    to the given buffer
+-------------------------------------------------*/
+
+static void put_32bits(UINT8 *data, UINT32 value)
+{
+	data[0] = value >> 0;
+	data[1] = value >> 8;
+	data[2] = value >> 16;
+	data[3] = value >> 24;
+}
+
+
+/*-------------------------------------------------
+    write_wav_header - write a WAV header for
+    16-bit PCM data of the given size
+-------------------------------------------------*/
+
+static int write_wav_header(core_file *file, const mfv_movie_info *info, UINT32 databytes)
+{
+	UINT8 header[44];
+
+	memcpy(&header[0], "RIFF", 4);
+	put_32bits(&header[4], 36 + databytes);
+	memcpy(&header[8], "WAVEfmt ", 8);
+	put_32bits(&header[16], 16);
+	header[20] = 1;                                         /* PCM */
+	header[21] = 0;
+	header[22] = info->audio_channels;
+	header[23] = 0;
+	put_32bits(&header[24], info->audio_samplerate);
+	put_32bits(&header[28], info->audio_samplerate * info->audio_channels * 2);
+	header[32] = info->audio_channels * 2;                  /* block align */
+	header[33] = 0;
+	header[34] = 16;                                        /* bits per sample */
+	header[35] = 0;
+	memcpy(&header[36], "data", 4);
+	put_32bits(&header[40], databytes);
+
+	core_fseek(file, 0, SEEK_SET);
+	return core_fwrite(file, header, sizeof(header)) == sizeof(header);
+}
+
+
+/*-------------------------------------------------
+    write_frame - write a frame out as a PNG
+-------------------------------------------------*/
+
+static int write_frame(const char *prefix, UINT32 framenum, bitmap_rgb32 &bitmap)
+{
+	astring filename;
+	core_file *file;
+	file_error filerr;
+	png_error pngerr;
+
+	filename.printf("%s%06d.png", prefix, framenum);
+	filerr = core_fopen(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &file);
+	if (filerr != FILERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to create '%s'\n", filename.cstr());
+		return FALSE;
+	}
+	pngerr = png_write_bitmap(file, NULL, bitmap, 0, NULL);
+	core_fclose(file);
+	if (pngerr != PNGERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to write '%s' (%d)\n", filename.cstr(), pngerr);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	const mfv_movie_info *info;
+	const char *filename = NULL;
+	const char *prefix = NULL;
+	core_file *wavfile = NULL;
+	mfv_file *movie = NULL;
+	INT16 *samples = NULL;
+	bitmap_rgb32 bitmap;
+	UINT32 frames = 0, samplecount = 0;
+	int infoonly = FALSE;
+	int usage = FALSE;
+	int result = 1;
+	int argnum;
+	core_file *file;
+	file_error filerr;
+	mfv_error mfverr;
+
+	/* parse the arguments */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-info") == 0)
+			infoonly = TRUE;
+		else if (filename == NULL && argv[argnum][0] != '-')
+			filename = argv[argnum];
+		else if (prefix == NULL && argv[argnum][0] != '-')
+			prefix = argv[argnum];
+		else
+			usage = TRUE;
+	}
+	if (filename == NULL || usage || (prefix == NULL && !infoonly))
+	{
+		fprintf(stderr, "Usage:\nmfvdecode -info <moviefile>\nmfvdecode <moviefile> <outputprefix>\n");
+		fprintf(stderr, "\nFrames are written as <outputprefix>NNNNNN.png and sound as <outputprefix>.wav\n");
+		return 1;
+	}
+
+	filerr = core_fopen(filename, OPEN_FLAG_READ, &file);
+	if (filerr != FILERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to open '%s'\n", filename);
+		return 1;
+	}
+	mfverr = mfv_open(file, &movie);
+	if (mfverr != MFVERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to read '%s' (%s)\n", filename, mfv_error_string(mfverr));
+		goto cleanup;
+	}
+
+	/* print the header */
+	info = mfv_get_movie_info(movie);
+	printf("Video: %dx%d, %d frames at %f Hz\n", info->video_width, info->video_height,
+			info->video_numframes, (double)info->video_timescale / (double)info->video_sampletime);
+	if (info->audio_samplerate != 0)
+		printf("Audio: %d channel(s), %d samples at %d Hz\n", info->audio_channels, info->audio_numsamples, info->audio_samplerate);
+	else
+		printf("Audio: none\n");
+	if (infoonly)
+	{
+		result = 0;
+		goto cleanup;
+	}
+
+	/* set up the sound output */
+	if (info->audio_samplerate != 0)
+	{
+		astring wavname(prefix, ".wav");
+		samples = (INT16 *)malloc(MFV_MAX_AUDIO_SAMPLES * info->audio_channels * sizeof(samples[0]));
+		filerr = core_fopen(wavname, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &wavfile);
+		if (samples == NULL || filerr != FILERR_NONE || !write_wav_header(wavfile, info, 0))
+		{
+			fprintf(stderr, "Error: unable to create '%s'\n", wavname.cstr());
+			goto cleanup;
+		}
+	}
+
+	/* decode everything */
+	for ( ; ; )
+	{
+		mfv_datatype type;
+		UINT32 numsamples;
+
+		mfverr = mfv_read_next(movie, &type, bitmap, samples, &numsamples);
+		if (mfverr == MFVERR_END)
+			break;
+		if (mfverr != MFVERR_NONE)
+		{
+			fprintf(stderr, "Error: %s after frame %d\n", mfv_error_string(mfverr), frames);
+			goto cleanup;
+		}
+
+		if (type == MFVDATA_VIDEO)
+		{
+			if (!write_frame(prefix, frames++, bitmap))
+				goto cleanup;
+		}
+		else
+		{
+			UINT32 bytes = numsamples * info->audio_channels * sizeof(samples[0]);
+			UINT32 sampnum;
+
+			/* WAV data is little-endian */
+			for (sampnum = 0; sampnum < numsamples * info->audio_channels; sampnum++)
+				samples[sampnum] = LITTLE_ENDIANIZE_INT16(samples[sampnum]);
+			if (core_fwrite(wavfile, samples, bytes) != bytes)
+			{
+				fprintf(stderr, "Error: unable to write sound data\n");
+				goto cleanup;
+			}
+			samplecount += numsamples;
+		}
+	}
+
+	/* finalize the sound */
+	if (wavfile != NULL && !write_wav_header(wavfile, info, samplecount * info->audio_channels * sizeof(samples[0])))
+	{
+		fprintf(stderr, "Error: unable to write sound data\n");
+		goto cleanup;
+	}
+	printf("Decoded %d frames and %d samples\n", frames, samplecount);
+	result = 0;
+
+cleanup:
+	if (wavfile != NULL)
+		core_fclose(wavfile);
+	if (samples != NULL)
+		free(samples);
+	if (movie != NULL)
+		mfv_close(movie);
+	core_fclose(file);
+	return result;
+}
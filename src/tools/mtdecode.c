@@ -0,0 +1,285 @@
+/***************************************************************************
+
+    mtdecode.c
+
+    Decoder for the memory access traces written by -memtrace.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "corestr.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* these mirror the definitions in src/emu/memtrace.h; see memtrace.c for the layout */
+#define MEMTRACE_MAGIC          "MAMETRC"
+#define MEMTRACE_VERSION        1
+
+#define MEMTRACE_SPACE_MASK     0x0f
+#define MEMTRACE_FLAG_WRITE     0x10
+#define MEMTRACE_FLAG_MASK      0x20
+#define MEMTRACE_FLAG_SAME_PC   0x40
+#define MEMTRACE_MAX_SPACES     (MEMTRACE_SPACE_MASK + 1)
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct trace_space
+{
+	char        name[256];      /* "<device tag>.<space name>" */
+	int         width;          /* data width in bytes */
+	int         addrchars;      /* hex digits in an address */
+	UINT64      fullmask;       /* mask of a full-width access */
+	UINT64      cycles;         /* cycles of the previous record */
+	UINT32      address;        /* address of the previous record */
+	UINT32      pc;             /* PC of the previous record */
+	UINT64      reads;          /* number of reads seen */
+	UINT64      writes;         /* number of writes seen */
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    get_varint - read a 7-bits-per-byte variable
+    length value; returns FALSE at end of file
+-------------------------------------------------*/
+
+static int get_varint(FILE *file, UINT64 *result)
+{
+	UINT64 value = 0;
+	int shift;
+
+	for (shift = 0; shift < 64; shift += 7)
+	{
+		int ch = fgetc(file);
+		if (ch == EOF)
+			return FALSE;
+		value |= (UINT64)(ch & 0x7f) << shift;
+		if ((ch & 0x80) == 0)
+		{
+			*result = value;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    get_delta - read a zigzag-encoded signed
+    delta
+-------------------------------------------------*/
+
+static int get_delta(FILE *file, INT64 *result)
+{
+	UINT64 value;
+	if (!get_varint(file, &value))
+		return FALSE;
+	*result = (INT64)(value >> 1) ^ -(INT64)(value & 1);
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    get_u32 - read a little-endian 32-bit value
+-------------------------------------------------*/
+
+static UINT32 get_u32(const UINT8 *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((UINT32)data[3] << 24);
+}
+
+
+/*-------------------------------------------------
+    read_header - read and validate the header
+    and the table of spaces
+-------------------------------------------------*/
+
+static int read_header(FILE *file, struct trace_space *spaces, int *numspaces)
+{
+	UINT8 header[16];
+	UINT32 version;
+	int spacenum;
+
+	if (fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, MEMTRACE_MAGIC, 8) != 0)
+	{
+		fprintf(stderr, "Error: not a memory trace file\n");
+		return FALSE;
+	}
+	version = get_u32(&header[8]);
+	if (version != MEMTRACE_VERSION)
+	{
+		fprintf(stderr, "Error: unsupported trace version %d\n", version);
+		return FALSE;
+	}
+	*numspaces = get_u32(&header[12]);
+	if (*numspaces > MEMTRACE_MAX_SPACES)
+	{
+		fprintf(stderr, "Error: trace has too many spaces (%d)\n", *numspaces);
+		return FALSE;
+	}
+
+	for (spacenum = 0; spacenum < *numspaces; spacenum++)
+	{
+		struct trace_space *space = &spaces[spacenum];
+		UINT8 info[3];
+
+		memset(space, 0, sizeof(*space));
+		if (fread(info, 1, sizeof(info), file) != sizeof(info) || fread(space->name, 1, info[2], file) != info[2])
+		{
+			fprintf(stderr, "Error: truncated space table\n");
+			return FALSE;
+		}
+		space->name[info[2]] = 0;
+		space->width = info[0];
+		space->addrchars = info[1];
+		space->fullmask = (space->width >= 8) ? ~(UINT64)0 : (((UINT64)1 << (space->width * 8)) - 1);
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    decode_records - decode records until the end
+    of the file, optionally printing each one
+-------------------------------------------------*/
+
+static int decode_records(FILE *file, struct trace_space *spaces, int numspaces, int filter, int quiet)
+{
+	int ch;
+
+	while ((ch = fgetc(file)) != EOF)
+	{
+		struct trace_space *space;
+		INT64 cycledelta, addrdelta, pcdelta;
+		UINT64 data, mask;
+
+		if ((ch & MEMTRACE_SPACE_MASK) >= numspaces)
+		{
+			fprintf(stderr, "Error: bad space index %d at offset %ld\n", ch & MEMTRACE_SPACE_MASK, ftell(file) - 1);
+			return FALSE;
+		}
+		space = &spaces[ch & MEMTRACE_SPACE_MASK];
+
+		/* pull the fields */
+		mask = space->fullmask;
+		pcdelta = 0;
+		if (!get_delta(file, &cycledelta) || !get_delta(file, &addrdelta) || !get_varint(file, &data) ||
+			((ch & MEMTRACE_FLAG_MASK) && !get_varint(file, &mask)) ||
+			(!(ch & MEMTRACE_FLAG_SAME_PC) && !get_delta(file, &pcdelta)))
+		{
+			fprintf(stderr, "Warning: trace ends with a truncated record\n");
+			return TRUE;
+		}
+
+		/* apply the deltas */
+		space->cycles += cycledelta;
+		space->address += (UINT32)addrdelta;
+		space->pc += (UINT32)pcdelta;
+		if (ch & MEMTRACE_FLAG_WRITE)
+			space->writes++;
+		else
+			space->reads++;
+
+		/* print the record */
+		if (!quiet && (filter < 0 || filter == (ch & MEMTRACE_SPACE_MASK)))
+		{
+			printf("%12" I64FMT "u %s %c %0*X=%0*" I64FMT "X", space->cycles, space->name,
+					(ch & MEMTRACE_FLAG_WRITE) ? 'W' : 'R', space->addrchars, space->address, space->width * 2, data);
+			if (mask != space->fullmask)
+				printf(" mask=%0*" I64FMT "X", space->width * 2, mask);
+			printf(" pc=%X\n", space->pc);
+		}
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	struct trace_space spaces[MEMTRACE_MAX_SPACES];
+	const char *filename = NULL;
+	const char *spacename = NULL;
+	int numspaces, spacenum;
+	int summary = FALSE;
+	int usage = FALSE;
+	int filter = -1;
+	int result = 1;
+	int argnum;
+	FILE *file;
+
+	/* parse the arguments */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-summary") == 0)
+			summary = TRUE;
+		else if (strcmp(argv[argnum], "-space") == 0 && argnum + 1 < argc)
+			spacename = argv[++argnum];
+		else if (filename == NULL && argv[argnum][0] != '-')
+			filename = argv[argnum];
+		else
+			usage = TRUE;
+	}
+	if (filename == NULL || usage)
+	{
+		fprintf(stderr, "Usage:\nmtdecode [-summary] [-space <tag.space>] <tracefile>\n");
+		return 1;
+	}
+
+	file = fopen(filename, "rb");
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: unable to open '%s'\n", filename);
+		return 1;
+	}
+	if (!read_header(file, spaces, &numspaces))
+		goto cleanup;
+
+	/* resolve the space filter */
+	if (spacename != NULL)
+	{
+		for (spacenum = 0; spacenum < numspaces; spacenum++)
+			if (core_stricmp(spaces[spacenum].name, spacename) == 0)
+				filter = spacenum;
+		if (filter < 0)
+		{
+			fprintf(stderr, "Error: trace has no space '%s'\n", spacename);
+			goto cleanup;
+		}
+	}
+
+	if (!decode_records(file, spaces, numspaces, filter, summary))
+		goto cleanup;
+
+	/* output the summary */
+	if (summary)
+		for (spacenum = 0; spacenum < numspaces; spacenum++)
+			printf("%-24s %12" I64FMT "u reads %12" I64FMT "u writes %14" I64FMT "u cycles\n",
+					spaces[spacenum].name, spaces[spacenum].reads, spaces[spacenum].writes, spaces[spacenum].cycles);
+	result = 0;
+
+cleanup:
+	fclose(file);
+	return result;
+}
@@ -63,6 +63,8 @@ TOOLS += \
 	split$(EXE) \
 	pngcmp$(EXE) \
 	nltool$(EXE) \
+	mtdecode$(EXE) \
+	mfvdecode$(EXE) \
 
 
 
@@ -219,3 +221,29 @@ NLTOOLOBJS = \
 nltool$(EXE): $(NLTOOLOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
 	@echo Linking $@...
 	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# mtdecode
+#-------------------------------------------------
+
+MTDECODEOBJS = \
+	$(TOOLSOBJ)/mtdecode.o \
+
+mtdecode$(EXE): $(MTDECODEOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# mfvdecode
+#-------------------------------------------------
+
+MFVDECODEOBJS = \
+	$(TOOLSOBJ)/mfvdecode.o \
+
+mfvdecode$(EXE): $(MFVDECODEOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@